@@ -0,0 +1,92 @@
+#pragma once
+// ベンチマークで共有する計測と入力データの作成
+#include "MathFunction.h"
+#include <chrono>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace Benchmark {
+
+// MeasureFastestNs で計測する回数
+const size_t kFastestOfSamples = 5;
+
+// 書き出した結果を使ったことにして、ループの外へ計算を追い出されないようにする
+inline void ClobberMemory() {
+#if defined(_MSC_VER)
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : : "memory");
+#endif
+}
+
+/// <summary>
+/// 作ったとき（Restart したとき）からの経過時間
+/// </summary>
+class Stopwatch {
+public:
+	Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+	void Restart() { start_ = std::chrono::steady_clock::now(); }
+
+	double GetNs() const { return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start_).count(); }
+	double GetMs() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count(); }
+
+private:
+	std::chrono::steady_clock::time_point start_;
+};
+
+/// <summary>
+/// func() を repeat 回呼ぶ時間を測る（呼ぶたびに ClobberMemory する）
+/// </summary>
+/// <returns>1回あたりのナノ秒</returns>
+template<typename Func> double MeasureNs(size_t repeat, Func&& func) {
+	Stopwatch stopwatch;
+	for (size_t r = 0; r < repeat; ++r) {
+		func();
+		ClobberMemory();
+	}
+	return stopwatch.GetNs() / static_cast<double>(repeat);
+}
+
+/// <summary>
+/// MeasureNs を samples 回繰り返し、一番速かった回の値を返す（割り込みなどで遅れた回を除く）
+/// </summary>
+template<typename Func> double MeasureFastestNs(size_t repeat, Func&& func, size_t samples = kFastestOfSamples) {
+	double fastest = MeasureNs(repeat, func);
+	for (size_t sample = 1; sample < samples; ++sample) {
+		fastest = (std::min)(fastest, MeasureNs(repeat, func));
+	}
+	return fastest;
+}
+
+// 各成分が [-range, range] の Vector3
+inline std::vector<Vector3> MakeRandomVectors(std::mt19937& rng, size_t count, float range) {
+	std::uniform_real_distribution<float> dist(-range, range);
+	std::vector<Vector3> result(count);
+	for (Vector3& v : result) {
+		v = {dist(rng), dist(rng), dist(rng)};
+	}
+	return result;
+}
+
+// 拡縮・回転・移動から作ったアフィン行列（withScale が false なら拡縮は1）
+inline std::vector<Matrix4x4> MakeRandomAffineMatrices(std::mt19937& rng, size_t count, bool withScale = true) {
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+	std::vector<Matrix4x4> result(count);
+	for (Matrix4x4& matrix : result) {
+		Vector3 s = withScale ? Vector3{scale(rng), scale(rng), scale(rng)} : Vector3{1.0f, 1.0f, 1.0f};
+		Vector3 rotate = {angle(rng), angle(rng), angle(rng)};
+		Vector3 translate = {position(rng), position(rng), position(rng)};
+		matrix = MakeAffineMatrix(s, rotate, translate);
+	}
+	return result;
+}
+
+} // namespace Benchmark
@@ -0,0 +1,191 @@
+// FastMath の精度段階ごとの誤差（ULP）と処理速度を測るベンチマーク
+#include "BenchmarkCommon.h"
+#include "FastMath.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+const size_t kDataCount = 4096;  // 速度計測に使う要素数
+const size_t kIterations = 500;  // データ全体を回す回数
+const size_t kErrorSamples = 1 << 20; // 誤差計測に使う入力の数
+
+const MathAccuracy kAccuracies[] = {MathAccuracy::Exact, MathAccuracy::Fast, MathAccuracy::Approx};
+
+// 配列全体を1回処理する関数を受け取り、1要素あたりのナノ秒を返す（何回か測り、一番速かった値）
+template<typename Func> double MeasureNsPerElement(Func func) { return Benchmark::MeasureFastestNs(kIterations, func) / static_cast<double>(kDataCount); }
+
+// 誤差の集計（ULP は正しい値を float に丸めたときの1ULPを単位にする）
+struct ErrorStats {
+	double maxUlp = 0.0;
+	double sumUlp = 0.0;
+	double maxAbs = 0.0;
+	size_t count = 0;
+
+	void Add(float value, double reference) {
+		float rounded = static_cast<float>(reference);
+		// 0付近で ULP が極端に小さくならないよう、|正しい値| が 2^-24 未満の所は 2^-24 の ULP で測る
+		double ulp = std::nextafter(std::fabs(rounded), INFINITY) - std::fabs(rounded);
+		ulp = std::fmax(ulp, 0x1p-47);
+		double error = std::fabs(static_cast<double>(value) - reference);
+		double errorUlp = error / ulp;
+		maxUlp = std::fmax(maxUlp, errorUlp);
+		maxAbs = std::fmax(maxAbs, error);
+		sumUlp += errorUlp;
+		++count;
+	}
+};
+
+void PrintError(const char* name, MathAccuracy accuracy, const ErrorStats& stats) {
+	std::printf("%-12s %-8s %14.2f %12.3f %14.3e\n", name, GetMathAccuracyName(accuracy), stats.maxUlp, stats.sumUlp / static_cast<double>(stats.count), stats.maxAbs);
+}
+
+void MeasureErrors() {
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> angleDist(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> exponentDist(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> componentDist(-10.0f, 10.0f);
+
+	std::vector<float> angles(kErrorSamples);
+	std::vector<float> positives(kErrorSamples);
+	std::vector<Vector3> vectors(kErrorSamples);
+	for (size_t i = 0; i < kErrorSamples; ++i) {
+		angles[i] = angleDist(rng);
+		positives[i] = std::exp2(exponentDist(rng));
+		vectors[i] = {componentDist(rng), componentDist(rng), componentDist(rng)};
+	}
+
+	std::vector<float> sinOut(kErrorSamples);
+	std::vector<float> cosOut(kErrorSamples);
+	std::vector<float> scalarOut(kErrorSamples);
+	std::vector<Vector3> vectorOut(kErrorSamples);
+
+	std::printf("--- error (|angle| <= 100, rsqrt in [2^-10, 2^10], vector components in [-10, 10]) ---\n");
+	std::printf("%-12s %-8s %14s %12s %14s\n", "kernel", "tier", "max ulp", "mean ulp", "max abs");
+	for (MathAccuracy accuracy : kAccuracies) {
+		FastMath::SinCosArray(angles.data(), kErrorSamples, sinOut.data(), cosOut.data(), accuracy);
+		ErrorStats sinStats, cosStats;
+		for (size_t i = 0; i < kErrorSamples; ++i) {
+			sinStats.Add(sinOut[i], std::sin(static_cast<double>(angles[i])));
+			cosStats.Add(cosOut[i], std::cos(static_cast<double>(angles[i])));
+		}
+		PrintError("sin", accuracy, sinStats);
+		PrintError("cos", accuracy, cosStats);
+
+		FastMath::RsqrtArray(positives.data(), kErrorSamples, scalarOut.data(), accuracy);
+		ErrorStats rsqrtStats;
+		for (size_t i = 0; i < kErrorSamples; ++i) {
+			rsqrtStats.Add(scalarOut[i], 1.0 / std::sqrt(static_cast<double>(positives[i])));
+		}
+		PrintError("rsqrt", accuracy, rsqrtStats);
+
+		FastMath::LengthArray(vectors.data(), kErrorSamples, scalarOut.data(), accuracy);
+		ErrorStats lengthStats;
+		for (size_t i = 0; i < kErrorSamples; ++i) {
+			const Vector3& v = vectors[i];
+			lengthStats.Add(scalarOut[i], std::sqrt(static_cast<double>(v.x) * v.x + static_cast<double>(v.y) * v.y + static_cast<double>(v.z) * v.z));
+		}
+		PrintError("length", accuracy, lengthStats);
+
+		FastMath::NormalizeArray(vectors.data(), kErrorSamples, vectorOut.data(), accuracy);
+		ErrorStats normalizeStats;
+		for (size_t i = 0; i < kErrorSamples; ++i) {
+			const Vector3& v = vectors[i];
+			double length = std::sqrt(static_cast<double>(v.x) * v.x + static_cast<double>(v.y) * v.y + static_cast<double>(v.z) * v.z);
+			normalizeStats.Add(vectorOut[i].x, v.x / length);
+			normalizeStats.Add(vectorOut[i].y, v.y / length);
+			normalizeStats.Add(vectorOut[i].z, v.z / length);
+		}
+		PrintError("normalize", accuracy, normalizeStats);
+	}
+}
+
+void MeasureThroughput() {
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> angleDist(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> positiveDist(0.01f, 100.0f);
+	std::uniform_real_distribution<float> componentDist(-10.0f, 10.0f);
+
+	std::vector<float> angles(kDataCount);
+	std::vector<float> positives(kDataCount);
+	std::vector<Vector3> vectors(kDataCount);
+	for (size_t i = 0; i < kDataCount; ++i) {
+		angles[i] = angleDist(rng);
+		positives[i] = positiveDist(rng);
+		vectors[i] = {componentDist(rng), componentDist(rng), componentDist(rng)};
+	}
+	std::vector<float> sinOut(kDataCount);
+	std::vector<float> cosOut(kDataCount);
+	std::vector<float> scalarOut(kDataCount);
+	std::vector<Vector3> vectorOut(kDataCount);
+
+	std::printf("\n--- throughput (ns/element, %zu elements) ---\n", kDataCount);
+	std::printf("%-12s %10s %10s %10s\n", "kernel", "Exact", "Fast", "Approx");
+
+	double result[3];
+	for (int tier = 0; tier < 3; ++tier) {
+		result[tier] = MeasureNsPerElement([&] { FastMath::SinCosArray(angles.data(), kDataCount, sinOut.data(), cosOut.data(), kAccuracies[tier]); });
+	}
+	std::printf("%-12s %10.3f %10.3f %10.3f\n", "sincos", result[0], result[1], result[2]);
+
+	for (int tier = 0; tier < 3; ++tier) {
+		result[tier] = MeasureNsPerElement([&] { FastMath::RsqrtArray(positives.data(), kDataCount, scalarOut.data(), kAccuracies[tier]); });
+	}
+	std::printf("%-12s %10.3f %10.3f %10.3f\n", "rsqrt", result[0], result[1], result[2]);
+
+	for (int tier = 0; tier < 3; ++tier) {
+		result[tier] = MeasureNsPerElement([&] { FastMath::LengthArray(vectors.data(), kDataCount, scalarOut.data(), kAccuracies[tier]); });
+	}
+	std::printf("%-12s %10.3f %10.3f %10.3f\n", "length", result[0], result[1], result[2]);
+
+	for (int tier = 0; tier < 3; ++tier) {
+		result[tier] = MeasureNsPerElement([&] { FastMath::NormalizeArray(vectors.data(), kDataCount, vectorOut.data(), kAccuracies[tier]); });
+	}
+	std::printf("%-12s %10.3f %10.3f %10.3f\n", "normalize", result[0], result[1], result[2]);
+
+	// 1要素ずつ呼ぶ場合（呼び出し側で精度段階を固定したテンプレート版）
+	result[0] = MeasureNsPerElement([&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			FastMath::SinCos<MathAccuracy::Exact>(angles[i], sinOut[i], cosOut[i]);
+		}
+	});
+	result[1] = MeasureNsPerElement([&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			FastMath::SinCos<MathAccuracy::Fast>(angles[i], sinOut[i], cosOut[i]);
+		}
+	});
+	result[2] = MeasureNsPerElement([&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			FastMath::SinCos<MathAccuracy::Approx>(angles[i], sinOut[i], cosOut[i]);
+		}
+	});
+	std::printf("%-12s %10.3f %10.3f %10.3f\n", "sincos (1)", result[0], result[1], result[2]);
+
+	result[0] = MeasureNsPerElement([&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			vectorOut[i] = FastMath::FastNormalize<MathAccuracy::Exact>(vectors[i]);
+		}
+	});
+	result[1] = MeasureNsPerElement([&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			vectorOut[i] = FastMath::FastNormalize<MathAccuracy::Fast>(vectors[i]);
+		}
+	});
+	result[2] = MeasureNsPerElement([&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			vectorOut[i] = FastMath::FastNormalize<MathAccuracy::Approx>(vectors[i]);
+		}
+	});
+	std::printf("%-12s %10.3f %10.3f %10.3f\n", "normalize (1)", result[0], result[1], result[2]);
+}
+
+} // namespace
+
+int main() {
+	std::printf("FastMath benchmark (backend: %s)\n\n", GetMathBackendName());
+	MeasureErrors();
+	MeasureThroughput();
+	return 0;
+}
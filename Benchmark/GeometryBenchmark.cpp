@@ -0,0 +1,493 @@
+// 行列・当たり判定・描画（線の生成まで）の各関数を、ランダムな入力で計測するベンチマーク。
+// Novice / DirectX には依存しないので Linux でそのまま動く。
+//
+// 使い方: GeometryBenchmark [--samples N] [--filter 文字列] [--json 出力先]
+//   --json を付けると結果をJSONで書き出す（"-" なら標準出力）。コミット間の比較に使う
+#include "BenchmarkCommon.h"
+#include "DebugDraw.h"
+#include "DebugScene.h"
+#include "Geometry.h"
+#include "LineRasterizer.h"
+#include "MathFunction.h"
+#include "Quaternion.h"
+#include "ThreadPool.h"
+#include "TriangleRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t kDataCount = 1024;         // 入力データの数（L1〜L2に収まる量）
+const double kMinSampleNs = 2000000.0;  // 1サンプルの最低計測時間（2ms）
+volatile float gSink = 0.0f;            // 最適化で計算が消されないようにする
+size_t gLineCount = 0;                  // 描画関数が出した線の数
+
+using Benchmark::MakeRandomAffineMatrices;
+using Benchmark::MakeRandomVectors;
+
+// 描画関数の出力先。線を数えるだけ
+void CountLine(int, int, int, int, unsigned int) { ++gLineCount; }
+
+// LineBatch の出力先。まとめて数えるだけ
+void CountLines(const ScreenLine*, size_t count) { gLineCount += count; }
+
+//=== ランダムな入力 ===//
+
+std::vector<AABB> MakeRandomAABBs(std::mt19937& rng, size_t count) {
+	std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+	std::uniform_real_distribution<float> extent(0.05f, 1.0f);
+	std::vector<AABB> result(count);
+	for (AABB& aabb : result) {
+		Vector3 center = {position(rng), position(rng), position(rng)};
+		Vector3 half = {extent(rng), extent(rng), extent(rng)};
+		aabb = {Subtract(center, half), Add(center, half)};
+	}
+	return result;
+}
+
+std::vector<OBB> MakeRandomOBBs(std::mt19937& rng, size_t count) {
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+	std::uniform_real_distribution<float> extent(0.05f, 1.0f);
+	std::vector<OBB> result(count);
+	for (OBB& obb : result) {
+		obb.center = {position(rng), position(rng), position(rng)};
+		obb.size = {extent(rng), extent(rng), extent(rng)};
+		SetOBBRotation(obb, MakeRotateQuaternion({angle(rng), angle(rng), angle(rng)}));
+	}
+	return result;
+}
+
+std::vector<Segment> MakeRandomSegments(std::mt19937& rng, size_t count) {
+	std::vector<Vector3> origins = MakeRandomVectors(rng, count, 3.0f);
+	std::vector<Vector3> diffs = MakeRandomVectors(rng, count, 3.0f);
+	std::vector<Segment> result(count);
+	for (size_t i = 0; i < count; ++i) {
+		result[i] = {origins[i], diffs[i]};
+	}
+	return result;
+}
+
+// 1280x720 の画面の線。9割は短い線（デバッグ描画の球や箱の辺くらい）、残りは画面を横切る長い線
+std::vector<ScreenLine> MakeRandomScreenLines(std::mt19937& rng, size_t count) {
+	std::uniform_int_distribution<int32_t> x(-64, 1280 + 64);
+	std::uniform_int_distribution<int32_t> y(-64, 720 + 64);
+	std::uniform_int_distribution<int32_t> offset(-24, 24);
+	std::uniform_int_distribution<uint32_t> color(0, 0xFFFFFF);
+	std::vector<ScreenLine> lines(count);
+	for (size_t i = 0; i < count; ++i) {
+		ScreenLine& line = lines[i];
+		line.x1 = x(rng);
+		line.y1 = y(rng);
+		if (i % 10 == 0) {
+			line.x2 = x(rng);
+			line.y2 = y(rng);
+		} else {
+			line.x2 = line.x1 + offset(rng);
+			line.y2 = line.y1 + offset(rng);
+		}
+		line.color = (color(rng) << 8) | 0xFF;
+	}
+	return lines;
+}
+
+// 1280x720 の画面の三角形。ほとんどは一辺数十ピクセル、100枚に1枚は画面の大半を覆う大きさ
+std::vector<ScreenTriangle> MakeRandomScreenTriangles(std::mt19937& rng, size_t count) {
+	std::uniform_real_distribution<float> x(-64.0f, 1280.0f + 64.0f);
+	std::uniform_real_distribution<float> y(-64.0f, 720.0f + 64.0f);
+	std::uniform_real_distribution<float> offset(-32.0f, 32.0f);
+	std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+	std::uniform_int_distribution<uint32_t> color(0, 0xFFFFFF);
+	std::vector<ScreenTriangle> triangles(count);
+	for (size_t i = 0; i < count; ++i) {
+		ScreenTriangle& triangle = triangles[i];
+		const float centerX = x(rng);
+		const float centerY = y(rng);
+		for (Vector3& vertex : triangle.vertices) {
+			vertex = (i % 100 == 0) ? Vector3{x(rng), y(rng), depth(rng)} : Vector3{centerX + offset(rng), centerY + offset(rng), depth(rng)};
+		}
+		triangle.color = (color(rng) << 8) | 0xFF;
+	}
+	return triangles;
+}
+
+// main.cpp と同じカメラ（少し揺らして複数用意する）
+std::vector<ScreenProjector> MakeRandomProjectors(std::mt19937& rng, size_t count) {
+	std::uniform_real_distribution<float> jitter(-0.1f, 0.1f);
+	Matrix4x4 projectionMatrix = MakePerspectiveFovMatrix(0.45f, 1280.0f / 720.0f, 0.1f, 100.0f);
+	Matrix4x4 viewportMatrix = MakeViewportMatrix(0.0f, 0.0f, 1280, 720, 0.0f, 1.0f);
+	std::vector<ScreenProjector> result(count);
+	for (ScreenProjector& projector : result) {
+		Vector3 cameraRotate = {0.26f + jitter(rng), jitter(rng), 0.0f};
+		Vector3 cameraTranslate = {jitter(rng), 1.9f + jitter(rng), -6.49f + jitter(rng)};
+		Matrix4x4 cameraMatrix = MakeQuaternionRotateTranslateMatrix(MakeRotateQuaternion(cameraRotate), cameraTranslate);
+		projector = ScreenProjector(Inverse(cameraMatrix, MatrixKind::Rigid), projectionMatrix, viewportMatrix);
+	}
+	return result;
+}
+
+//=== 計測 ===//
+
+struct Result {
+	std::string name;
+	size_t samples;
+	double meanNs;   // 1回あたりの平均（ns）
+	double stddevNs; // サンプル間の標準偏差（ns）
+	double minNs;
+	double maxNs;
+	double opsPerSecond;
+};
+
+// 1サンプル分（データ全体を repeat 回）を計測して、1回あたりのナノ秒を返す
+template<typename Func> double MeasureSample(Func& func, size_t repeat) {
+	return Benchmark::MeasureNs(repeat, [&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			func(i);
+		}
+	}) / static_cast<double>(kDataCount);
+}
+
+// 1サンプルが kMinSampleNs 以上になる回数を決めてから samples 回計測する
+template<typename Func> Result Measure(const char* name, size_t samples, Func func) {
+	// ウォームアップを兼ねて回数を決める
+	size_t repeat = 1;
+	while (MeasureSample(func, repeat) * static_cast<double>(repeat * kDataCount) < kMinSampleNs && repeat < (1u << 20)) {
+		repeat *= 2;
+	}
+
+	std::vector<double> ns(samples);
+	for (double& sample : ns) {
+		sample = MeasureSample(func, repeat);
+	}
+
+	double sum = 0.0;
+	for (double sample : ns) {
+		sum += sample;
+	}
+	double mean = sum / static_cast<double>(samples);
+	double variance = 0.0;
+	for (double sample : ns) {
+		variance += (sample - mean) * (sample - mean);
+	}
+	variance /= static_cast<double>(samples > 1 ? samples - 1 : 1);
+
+	Result result;
+	result.name = name;
+	result.samples = samples;
+	result.meanNs = mean;
+	result.stddevNs = std::sqrt(variance);
+	result.minNs = *std::min_element(ns.begin(), ns.end());
+	result.maxNs = *std::max_element(ns.begin(), ns.end());
+	result.opsPerSecond = 1.0e9 / mean;
+	return result;
+}
+
+void PrintResult(const Result& result) {
+	std::printf(
+	    "%-22s %10.2f %9.2f %6.1f%% %10.2f %14.0f\n", result.name.c_str(), result.meanNs, result.stddevNs, 100.0 * result.stddevNs / result.meanNs, result.minNs,
+	    result.opsPerSecond);
+}
+
+bool WriteJson(const char* path, const std::vector<Result>& results, size_t lines) {
+	FILE* file = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "w");
+	if (!file) {
+		return false;
+	}
+	std::fprintf(file, "{\n  \"simd\": \"%s\",\n  \"dataCount\": %zu,\n  \"lines\": %zu,\n  \"results\": [\n", GetMathBackendName(), kDataCount, lines);
+	for (size_t i = 0; i < results.size(); ++i) {
+		const Result& r = results[i];
+		std::fprintf(
+		    file, "    {\"name\": \"%s\", \"samples\": %zu, \"nsPerOp\": %.4f, \"stddevNs\": %.4f, \"varianceNs2\": %.6f, \"minNs\": %.4f, \"maxNs\": %.4f, \"opsPerSecond\": %.1f}%s\n",
+		    r.name.c_str(), r.samples, r.meanNs, r.stddevNs, r.stddevNs * r.stddevNs, r.minNs, r.maxNs, r.opsPerSecond, i + 1 < results.size() ? "," : "");
+	}
+	std::fprintf(file, "  ]\n}\n");
+	if (file != stdout) {
+		std::fclose(file);
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	size_t samples = 10;
+	const char* filter = nullptr;
+	const char* jsonPath = nullptr;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+			samples = std::max<size_t>(2, std::strtoul(argv[++i], nullptr, 10));
+		} else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			filter = argv[++i];
+		} else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+			jsonPath = argv[++i];
+		} else {
+			std::fprintf(stderr, "usage: %s [--samples N] [--filter name] [--json path|-]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::mt19937 rng(12345);
+	std::vector<Matrix4x4> matricesA = MakeRandomAffineMatrices(rng, kDataCount);
+	std::vector<Matrix4x4> matricesB = MakeRandomAffineMatrices(rng, kDataCount);
+	std::vector<Vector3> points = MakeRandomVectors(rng, kDataCount, 10.0f);
+	std::vector<Vector3> scales = MakeRandomVectors(rng, kDataCount, 4.0f);
+	std::vector<Vector3> rotates = MakeRandomVectors(rng, kDataCount, 3.14f);
+	std::vector<Vector3> translates = MakeRandomVectors(rng, kDataCount, 10.0f);
+	std::vector<AABB> aabbs = MakeRandomAABBs(rng, kDataCount);
+	std::vector<OBB> obbs = MakeRandomOBBs(rng, kDataCount);
+	std::vector<Matrix4x4> obbMatrices(kDataCount);
+	for (size_t i = 0; i < kDataCount; ++i) {
+		obbMatrices[i] = MakeOBBWorldMatrix(obbs[i]);
+	}
+	std::vector<Segment> segments = MakeRandomSegments(rng, kDataCount);
+	std::vector<Vector3> controlPoints = MakeRandomVectors(rng, kDataCount * 3, 2.0f);
+	std::vector<Vector3> sphereCenters = MakeRandomVectors(rng, kDataCount, 2.0f);
+	std::vector<float> radii(kDataCount);
+	std::uniform_real_distribution<float> radius(0.05f, 1.0f);
+	for (float& r : radii) {
+		r = radius(rng);
+	}
+	std::vector<Plane> planes(kDataCount);
+	std::vector<Triangle> triangles(kDataCount);
+	{
+		std::vector<Vector3> normals = MakeRandomVectors(rng, kDataCount, 1.0f);
+		std::vector<Vector3> vertices = MakeRandomVectors(rng, kDataCount * 3, 2.0f);
+		std::uniform_real_distribution<float> distance(-1.0f, 1.0f);
+		for (size_t i = 0; i < kDataCount; ++i) {
+			planes[i] = {Normalize(normals[i]), distance(rng)};
+			triangles[i] = {vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]};
+		}
+	}
+	std::vector<ScreenProjector> projectors = MakeRandomProjectors(rng, kDataCount);
+	std::vector<Matrix4x4> matrixOut(kDataCount);
+	std::vector<Vector3> vectorOut(kDataCount);
+	size_t hits = 0;
+
+	SetLineDrawFunction(CountLine);
+
+	std::printf("%-22s %10s %9s %7s %10s %14s\n", "function", "ns/op", "stddev", "cv", "min", "ops/s");
+	std::vector<Result> results;
+	auto run = [&](const char* name, auto func) {
+		if (filter && !std::strstr(name, filter)) {
+			return;
+		}
+		results.push_back(Measure(name, samples, func));
+		PrintResult(results.back());
+	};
+
+	const uint32_t kColor = 0xFFFFFFFF;
+	run("MatrixMultiply", [&](size_t i) { matrixOut[i] = MatrixMultiply(matricesA[i], matricesB[i]); });
+	run("Inverse", [&](size_t i) { matrixOut[i] = Inverse(matricesA[i]); });
+	run("Inverse(Affine)", [&](size_t i) { matrixOut[i] = Inverse(matricesA[i], MatrixKind::Affine); });
+	run("Transform", [&](size_t i) { vectorOut[i] = Transform(points[i], matricesA[i]); });
+	run("MakeAffineMatrix", [&](size_t i) { matrixOut[i] = MakeAffineMatrix(scales[i], rotates[i], translates[i]); });
+	run("IsCollision(AABB)", [&](size_t i) { hits += IsCollision(aabbs[i], segments[i]) ? 1 : 0; });
+	run("IsCollisionOBBLine", [&](size_t i) { hits += IsCollisionOBBLine(obbs[i], obbMatrices[i], segments[i]) ? 1 : 0; });
+	// 視錐台の判定（配列版は i == 0 のときにデータ全体を1回で処理するので、1個あたりの時間になる）
+	const Frustum& frustum = projectors[0].GetFrustum();
+	std::vector<Sphere> spheres(kDataCount);
+	for (size_t i = 0; i < kDataCount; ++i) {
+		spheres[i] = {sphereCenters[i], radii[i]};
+	}
+	std::unique_ptr<bool[]> cullVisible(new bool[kDataCount]);
+	run("IsVisible(Sphere)", [&](size_t i) { cullVisible[i] = IsVisible(frustum, spheres[i]); });
+	run("CullSpheres", [&](size_t i) {
+		if (i == 0) {
+			hits += CullSpheres(frustum, spheres.data(), kDataCount, cullVisible.get());
+		}
+	});
+	run("IsVisible(AABB)", [&](size_t i) { cullVisible[i] = IsVisible(frustum, aabbs[i]); });
+	run("CullAABBs", [&](size_t i) {
+		if (i == 0) {
+			hits += CullAABBs(frustum, aabbs.data(), kDataCount, cullVisible.get());
+		}
+	});
+	run("IsVisible(OBB)", [&](size_t i) { cullVisible[i] = IsVisible(frustum, obbs[i]); });
+	run("CullOBBs", [&](size_t i) {
+		if (i == 0) {
+			hits += CullOBBs(frustum, obbs.data(), kDataCount, cullVisible.get());
+		}
+	});
+	run("Bezier", [&](size_t i) { vectorOut[i] = Bezier(controlPoints[i * 3], controlPoints[i * 3 + 1], controlPoints[i * 3 + 2], 0.37f); });
+	run("DrawGrid", [&](size_t i) { DrawGrid(projectors[i]); });
+	run("DrawSegment", [&](size_t i) { DrawSegment(segments[i].origin, segments[i].diff, projectors[i], kColor); });
+	run("DrawPlane", [&](size_t i) { DrawPlane(planes[i], projectors[i], kColor); });
+	run("DrawTriangle", [&](size_t i) { DrawTriangle(triangles[i], projectors[i], kColor); });
+	run("DrawAABB", [&](size_t i) { DrawAABB(aabbs[i], projectors[i], kColor); });
+	run("DrawOBB", [&](size_t i) { DrawOBB(obbs[i].size, obbMatrices[i], projectors[i], kColor); });
+	run("DrawSphere", [&](size_t i) { DrawSphere(sphereCenters[i], radii[i], projectors[i], kColor); });
+	run("DrawBezier", [&](size_t i) { DrawBezier(controlPoints[i * 3], controlPoints[i * 3 + 1], controlPoints[i * 3 + 2], projectors[i], kColor); });
+
+	// カメラが止まっているとき。番号を付けたプロジェクターなら、変換した頂点を使い回す
+	const ScreenProjector& stillProjector = projectors[0];
+	ScreenProjector stampedProjector = projectors[0];
+	CameraVersionCounter cameraVersion;
+	cameraVersion.Stamp(stampedProjector);
+	ProjectionCache staticGrid;
+	const uint32_t gridShape = AddStaticGrid(staticGrid);
+	ProjectionCache staticBoxes;
+	std::vector<uint32_t> staticBoxShapes(kDataCount);
+	for (size_t i = 0; i < kDataCount; ++i) {
+		staticBoxShapes[i] = AddStaticAABB(staticBoxes, aabbs[i]);
+	}
+	run("DrawGrid(Still)", [&](size_t) { DrawGrid(stillProjector); });
+	run("DrawGrid(Cached)", [&](size_t) { DrawStaticGrid(staticGrid, gridShape, stampedProjector); });
+	run("DrawAABB(Still)", [&](size_t i) { DrawAABB(aabbs[i], stillProjector, kColor); });
+	run("DrawStaticBox", [&](size_t i) { DrawStaticBox(staticBoxes, staticBoxShapes[i], stampedProjector, kColor); });
+
+	// 画面上の大きさで分割数を選ぶ（前回の分割数を1個ずつ持つ）
+	std::vector<uint32_t> sphereLods(kDataCount, 0);
+	std::vector<uint32_t> bezierLods(kDataCount, 0);
+	run("DrawSphereLod", [&](size_t i) { DrawSphereLod(sphereCenters[i], radii[i], projectors[i], kColor, sphereLods[i]); });
+	run("DrawBezierLod", [&](size_t i) { DrawBezierLod(controlPoints[i * 3], controlPoints[i * 3 + 1], controlPoints[i * 3 + 2], projectors[i], kColor, bezierLods[i]); });
+
+	// LineBatch にためてデータ1周ごとにまとめて渡す
+	LineBatch lineBatch(CountLines);
+	SetLineBatch(&lineBatch);
+	auto flushAtEnd = [&](size_t i) {
+		if (i + 1 == kDataCount) {
+			lineBatch.Flush();
+		}
+	};
+	run("DrawAABB(batch)", [&](size_t i) {
+		DrawAABB(aabbs[i], projectors[i], kColor);
+		flushAtEnd(i);
+	});
+	run("DrawSphere(batch)", [&](size_t i) {
+		DrawSphere(sphereCenters[i], radii[i], projectors[i], kColor);
+		flushAtEnd(i);
+	});
+	run("DrawBezier(batch)", [&](size_t i) {
+		DrawBezier(controlPoints[i * 3], controlPoints[i * 3 + 1], controlPoints[i * 3 + 2], projectors[i], kColor);
+		flushAtEnd(i);
+	});
+	SetLineBatch(nullptr);
+
+	// ソフトウェアラスタライザ。1回目の i で1フレーム分（kRasterLineCount 本）を描くので、ns/op × kDataCount が1フレームの時間
+	const size_t kRasterLineCount = 100000;
+	std::vector<ScreenLine> screenLines = MakeRandomScreenLines(rng, kRasterLineCount);
+	Framebuffer framebuffer(1280, 720);
+	LineRasterizer rasterizer;
+	auto rasterize = [&](const char* name, LineRasterMode mode) {
+		rasterizer.SetMode(mode);
+		run(name, [&](size_t i) {
+			if (i == 0) {
+				framebuffer.Clear(0x000000FF);
+				rasterizer.Rasterize(screenLines.data(), screenLines.size(), framebuffer);
+			}
+		});
+		if (!results.empty() && results.back().name == name) {
+			std::printf("%-22s %10.3f ms/frame (%zu lines, %u threads)\n", "", results.back().meanNs * kDataCount * 1.0e-6, kRasterLineCount, ThreadPool::GetInstance()->GetWorkerCount() + 1);
+		}
+	};
+	rasterize("RasterizeLines", LineRasterMode::kAliased);
+	rasterize("RasterizeLines(AA)", LineRasterMode::kAntialiased);
+
+	// 深度テスト付きの塗りつぶし。こちらも1回目の i で1フレーム分（kRasterTriangleCount 枚）
+	const size_t kRasterTriangleCount = 20000;
+	std::vector<ScreenTriangle> screenTriangles = MakeRandomScreenTriangles(rng, kRasterTriangleCount);
+	DepthBuffer depthBuffer(1280, 720);
+	TriangleRasterizer triangleRasterizer;
+	run("RasterizeTriangles", [&](size_t i) {
+		if (i == 0) {
+			framebuffer.Clear(0x000000FF);
+			depthBuffer.Clear();
+			triangleRasterizer.Rasterize(screenTriangles.data(), screenTriangles.size(), framebuffer, depthBuffer);
+		}
+	});
+	if (!results.empty() && results.back().name == "RasterizeTriangles") {
+		std::printf("%-22s %10.3f ms/frame (%zu triangles)\n", "", results.back().meanNs * kDataCount * 1.0e-6, kRasterTriangleCount);
+	}
+	hits += framebuffer.GetPixel(640, 360);
+
+	// 箱を塗る三角形を作るまで（データ1周ごとに捨てる）
+	std::vector<ScreenTriangle> triangleBatch;
+	SetTriangleBatch(&triangleBatch);
+	auto clearAtEnd = [&](size_t i) {
+		if (i + 1 == kDataCount) {
+			hits += triangleBatch.size();
+			triangleBatch.clear();
+		}
+	};
+	run("FillAABB", [&](size_t i) {
+		FillAABB(aabbs[i], projectors[i], kColor);
+		clearAtEnd(i);
+	});
+	run("FillOBB", [&](size_t i) {
+		FillOBB(obbs[i].size, obbMatrices[i], projectors[i], kColor);
+		clearAtEnd(i);
+	});
+	SetTriangleBatch(nullptr);
+
+	// 1回目の i で1フレーム分を描いて LineBatch を渡す。まずは kFrameBoxCount 個の箱を、1個ずつ描く関数と配列版で比べる
+	const size_t kFrameBoxCount = 50000;
+	std::vector<AABB> frameAABBs = MakeRandomAABBs(rng, kFrameBoxCount);
+	std::vector<OBB> frameOBBs = MakeRandomOBBs(rng, kFrameBoxCount);
+	std::vector<Vector3> frameOBBSizes(kFrameBoxCount);
+	std::vector<Matrix4x4> frameOBBMatrices(kFrameBoxCount);
+	for (size_t i = 0; i < kFrameBoxCount; ++i) {
+		frameOBBSizes[i] = frameOBBs[i].size;
+		frameOBBMatrices[i] = MakeOBBWorldMatrix(frameOBBs[i]);
+	}
+	lineBatch.Reserve(kFrameBoxCount * 12);
+	SetLineBatch(&lineBatch);
+	auto drawFrame = [&](const char* name, auto draw) {
+		run(name, [&](size_t i) {
+			if (i == 0) {
+				draw();
+				lineBatch.Flush();
+			}
+		});
+		if (!results.empty() && results.back().name == name) {
+			std::printf("%-22s %10.3f ms/frame\n", "", results.back().meanNs * kDataCount * 1.0e-6);
+		}
+	};
+	drawFrame("DrawAABB(frame)", [&] {
+		for (const AABB& aabb : frameAABBs) {
+			DrawAABB(aabb, stillProjector, kColor);
+		}
+	});
+	drawFrame("DrawAABBs", [&] { DrawAABBs(frameAABBs.data(), kFrameBoxCount, stillProjector, kColor); });
+	drawFrame("DrawOBB(frame)", [&] {
+		for (size_t i = 0; i < kFrameBoxCount; ++i) {
+			DrawOBB(frameOBBSizes[i], frameOBBMatrices[i], stillProjector, kColor);
+		}
+	});
+	drawFrame("DrawOBBs", [&] { DrawOBBs(frameOBBSizes.data(), frameOBBMatrices.data(), kFrameBoxCount, stillProjector, kColor); });
+	drawFrame("DrawOBBs(OBB)", [&] { DrawOBBs(frameOBBs.data(), kFrameBoxCount, stillProjector, kColor); });
+
+	// 動かない球・箱・ベジエ曲線を kDataCount 個ずつ。毎フレーム描き直すのと、DebugScene に登録しておくのを比べる
+	DebugScene debugScene;
+	for (size_t i = 0; i < kDataCount; ++i) {
+		debugScene.AddSphere(sphereCenters[i], radii[i], kColor);
+		debugScene.AddAABB(aabbs[i], kColor);
+		debugScene.AddBezier(controlPoints[i * 3], controlPoints[i * 3 + 1], controlPoints[i * 3 + 2], kColor);
+	}
+	drawFrame("Immediate(scene)", [&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			DrawSphere(sphereCenters[i], radii[i], stampedProjector, kColor);
+			DrawAABB(aabbs[i], stampedProjector, kColor);
+			DrawBezier(controlPoints[i * 3], controlPoints[i * 3 + 1], controlPoints[i * 3 + 2], stampedProjector, kColor);
+		}
+	});
+	drawFrame("DebugScene", [&] { debugScene.Draw(stampedProjector); });
+	SetLineBatch(nullptr);
+
+	for (size_t i = 0; i < kDataCount; ++i) {
+		gSink = gSink + matrixOut[i].m[0][0] + vectorOut[i].x;
+	}
+	gSink = gSink + static_cast<float>(hits);
+
+	if (jsonPath && !WriteJson(jsonPath, results, gLineCount)) {
+		std::fprintf(stderr, "cannot write %s\n", jsonPath);
+		return 1;
+	}
+	return 0;
+}
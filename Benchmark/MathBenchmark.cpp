@@ -0,0 +1,423 @@
+// MathFunction のスカラー実装とSIMD実装を関数ごとに比較するベンチマーク
+#include "Affine3x4.h"
+#include "BenchmarkCommon.h"
+#include "MathFunction.h"
+#include "Quaternion.h"
+#include "TransformHierarchy.h"
+#include "Vec3Stream.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+const size_t kDataCount = 1024;      // 入力データの数（L1に収まる量）
+const size_t kIterations = 2000;     // データ全体を回す回数
+volatile float gSink = 0.0f;         // 最適化で計算が消されないようにする
+
+using Benchmark::ClobberMemory;
+using Benchmark::MakeRandomAffineMatrices;
+using Benchmark::MakeRandomVectors;
+using Benchmark::Stopwatch;
+
+std::vector<Matrix4x4> MakeRandomMatrices(std::mt19937& rng, size_t count) {
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<Matrix4x4> result(count);
+	for (Matrix4x4& matrix : result) {
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				matrix.m[i][j] = dist(rng);
+			}
+		}
+		// Transformで w が 0 にならないように
+		matrix.m[3][3] = 4.0f;
+	}
+	return result;
+}
+
+// 1回あたりのナノ秒を計測する（データ全体を kIterations 回回すのを何回か測り、一番速かった値）
+template<typename Func> double MeasureNsPerOp(Func func) {
+	return Benchmark::MeasureFastestNs(kIterations, [&] {
+		for (size_t i = 0; i < kDataCount; ++i) {
+			func(i);
+		}
+	}) / static_cast<double>(kDataCount);
+}
+
+// m × inverse が単位行列からどれだけずれているか（要素ごとの最大誤差）
+float MaxIdentityError(const Matrix4x4& m, const Matrix4x4& inverse) {
+	Matrix4x4 product = MathScalar::MatrixMultiply(m, inverse);
+	float error = 0.0f;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			float expected = (i == j) ? 1.0f : 0.0f;
+			error = std::max(error, std::fabs(product.m[i][j] - expected));
+		}
+	}
+	return error;
+}
+
+// 2つの行列の要素ごとの最大差
+float MaxDifference(const Matrix4x4& a, const Matrix4x4& b) {
+	float difference = 0.0f;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			difference = std::max(difference, std::fabs(a.m[i][j] - b.m[i][j]));
+		}
+	}
+	return difference;
+}
+
+void PrintResult(const char* name, double scalarNs, double simdNs) { std::printf("%-16s %10.3f %10.3f %8.2fx\n", name, scalarNs, simdNs, scalarNs / simdNs); }
+
+} // namespace
+
+int main() {
+	std::mt19937 rng(12345);
+	std::vector<Vector3> vectors = MakeRandomVectors(rng, kDataCount, 10.0f);
+	std::vector<Matrix4x4> matricesA = MakeRandomMatrices(rng, kDataCount);
+	std::vector<Matrix4x4> matricesB = MakeRandomMatrices(rng, kDataCount);
+
+	// 結果は配列に書き出して、依存チェーンではなくスループットを計る
+	std::vector<Matrix4x4> matrixOut(kDataCount);
+	std::vector<Vector3> vectorOut(kDataCount);
+
+	std::printf("backend: %s\n", GetMathBackendName());
+	std::printf("%-16s %10s %10s %9s\n", "function", "scalar ns", "simd ns", "speedup");
+
+	{
+		double scalar = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MathScalar::MatrixMultiply(matricesA[i], matricesB[i]); });
+		double simd = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MatrixMultiply(matricesA[i], matricesB[i]); });
+		PrintResult("MatrixMultiply", scalar, simd);
+	}
+	{
+		double scalar = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MathScalar::MatrixAdd(matricesA[i], matricesB[i]); });
+		double simd = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MatrixAdd(matricesA[i], matricesB[i]); });
+		PrintResult("MatrixAdd", scalar, simd);
+	}
+	{
+		double scalar = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MathScalar::MatrixSubtract(matricesA[i], matricesB[i]); });
+		double simd = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MatrixSubtract(matricesA[i], matricesB[i]); });
+		PrintResult("MatrixSubtract", scalar, simd);
+	}
+	{
+		double scalar = MeasureNsPerOp([&](size_t i) { vectorOut[i] = MathScalar::Transform(vectors[i], matricesA[i]); });
+		double simd = MeasureNsPerOp([&](size_t i) { vectorOut[i] = Transform(vectors[i], matricesA[i]); });
+		PrintResult("Transform", scalar, simd);
+	}
+	{
+		// 1点あたりの時間で比べる。スカラー側は1点ずつ Transform を呼ぶ従来の書き方
+		const size_t kBatch = 64;
+		double scalar = MeasureNsPerOp([&](size_t i) { vectorOut[i] = MathScalar::Transform(vectors[i], matricesA[0]); });
+		double simd = MeasureNsPerOp([&](size_t i) {
+			if (i % kBatch == 0) {
+				TransformPoints(&vectors[i], kBatch, matricesA[0], &vectorOut[i]);
+			}
+		});
+		PrintResult("TransformPoints", scalar, simd);
+	}
+	{
+		double scalar = MeasureNsPerOp([&](size_t i) { vectorOut[i] = MathScalar::Add(vectors[i], vectors[kDataCount - 1 - i]); });
+		double simd = MeasureNsPerOp([&](size_t i) { vectorOut[i] = (vectors[i] + vectors[kDataCount - 1 - i]); });
+		PrintResult("Vector3 +", scalar, simd);
+	}
+	{
+		double scalar = MeasureNsPerOp([&](size_t i) { vectorOut[i] = MathScalar::Subtract(vectors[i], vectors[kDataCount - 1 - i]); });
+		double simd = MeasureNsPerOp([&](size_t i) { vectorOut[i] = (vectors[i] - vectors[kDataCount - 1 - i]); });
+		PrintResult("Vector3 -", scalar, simd);
+	}
+	{
+		double scalar = MeasureNsPerOp([&](size_t i) { vectorOut[i] = MathScalar::Multiply(1.5f, vectors[i]); });
+		double simd = MeasureNsPerOp([&](size_t i) { vectorOut[i] = (1.5f * vectors[i]); });
+		PrintResult("Vector3 *", scalar, simd);
+	}
+
+	// 演算子の連鎖（main のバネの力の計算と同じ形）。MATH_EXPRESSION_TEMPLATES の有無で比べる
+	{
+#if defined(MATH_EXPRESSION_TEMPLATES)
+		const char* mode = "expression";
+#else
+		const char* mode = "value";
+#endif
+		const float stiffness = 100.0f;
+		const float damping = 2.0f;
+		double manual = MeasureNsPerOp([&](size_t i) {
+			const Vector3& position = vectors[i];
+			const Vector3& velocity = vectors[kDataCount - 1 - i];
+			float length = 1.5f;
+			vectorOut[i] = {
+			    -stiffness * (length * (position.x - velocity.x)) + -damping * velocity.x,
+			    -stiffness * (length * (position.y - velocity.y)) + -damping * velocity.y,
+			    -stiffness * (length * (position.z - velocity.z)) + -damping * velocity.z,
+			};
+		});
+		double chain = MeasureNsPerOp([&](size_t i) {
+			const Vector3& position = vectors[i];
+			const Vector3& velocity = vectors[kDataCount - 1 - i];
+			float length = 1.5f;
+			vectorOut[i] = -stiffness * (length * (position - velocity)) + -damping * velocity;
+		});
+		std::printf("\n%-16s %10s %10s %9s  (%s operators)\n", "operator chain", "manual ns", "chain ns", "ratio", mode);
+		PrintResult("SpringForce", manual, chain);
+	}
+
+	// 逆行列：一般の余因子展開と、アフィン・剛体用の近道を速度と精度で比べる
+	{
+		std::vector<Matrix4x4> affineMatrices = MakeRandomAffineMatrices(rng, kDataCount, true);
+		std::vector<Matrix4x4> rigidMatrices = MakeRandomAffineMatrices(rng, kDataCount, false);
+
+		std::printf("\n%-16s %10s %9s %12s %12s\n", "inverse", "ns/op", "speedup", "max |MM^-1-I|", "max |diff|");
+		double general = MeasureNsPerOp([&](size_t i) { matrixOut[i] = InverseGeneral(affineMatrices[i]); });
+		double affine = MeasureNsPerOp([&](size_t i) { matrixOut[i] = InverseAffine(affineMatrices[i]); });
+		double rigid = MeasureNsPerOp([&](size_t i) { matrixOut[i] = InverseRigid(rigidMatrices[i]); });
+
+		float generalError = 0.0f;
+		float affineError = 0.0f;
+		float rigidError = 0.0f;
+		float affineDifference = 0.0f;
+		float rigidDifference = 0.0f;
+		for (size_t i = 0; i < kDataCount; ++i) {
+			Matrix4x4 affineReference = InverseGeneral(affineMatrices[i]);
+			Matrix4x4 rigidReference = InverseGeneral(rigidMatrices[i]);
+			generalError = std::max(generalError, MaxIdentityError(affineMatrices[i], affineReference));
+			affineError = std::max(affineError, MaxIdentityError(affineMatrices[i], InverseAffine(affineMatrices[i])));
+			rigidError = std::max(rigidError, MaxIdentityError(rigidMatrices[i], InverseRigid(rigidMatrices[i])));
+			affineDifference = std::max(affineDifference, MaxDifference(affineReference, InverseAffine(affineMatrices[i])));
+			rigidDifference = std::max(rigidDifference, MaxDifference(rigidReference, InverseRigid(rigidMatrices[i])));
+		}
+		std::printf("%-16s %10.3f %8.2fx %12.3e %12s\n", "InverseGeneral", general, 1.0, generalError, "-");
+		std::printf("%-16s %10.3f %8.2fx %12.3e %12.3e\n", "InverseAffine", affine, general / affine, affineError, affineDifference);
+		std::printf("%-16s %10.3f %8.2fx %12.3e %12.3e\n", "InverseRigid", rigid, general / rigid, rigidError, rigidDifference);
+	}
+
+	// アフィン行列の作成：5つの行列を掛け合わせる従来の作り方と閉じた形を比べる
+	{
+		std::printf("\n%-16s %10s %10s %9s\n", "affine build", "old ns", "new ns", "speedup");
+		double old = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MathScalar::MakeAffineMatrix(vectors[i], vectors[kDataCount - 1 - i], vectors[(i * 7) % kDataCount]); });
+		double closed = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MakeAffineMatrix(vectors[i], vectors[kDataCount - 1 - i], vectors[(i * 7) % kDataCount]); });
+		PrintResult("MakeAffine", old, closed);
+		old = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MathScalar::MakeAffineMatrix({1.0f, 1.0f, 1.0f}, vectors[kDataCount - 1 - i], vectors[i]); });
+		closed = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MakeRotateTranslateMatrix(vectors[kDataCount - 1 - i], vectors[i]); });
+		PrintResult("RotateTranslate", old, closed);
+		old = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MathScalar::MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, vectors[i]); });
+		closed = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MakeTranslateMatrix(vectors[i]); });
+		PrintResult("Translate", old, closed);
+	}
+
+	// 48バイトのアフィン行列と Matrix4x4 を比べる
+	{
+		std::vector<Matrix4x4> affineMatrices = MakeRandomAffineMatrices(rng, kDataCount, true);
+		std::vector<Affine3x4> affines(kDataCount);
+		std::vector<Affine3x4> affineOut(kDataCount);
+		for (size_t i = 0; i < kDataCount; ++i) {
+			affines[i] = MakeAffine3x4(affineMatrices[i]);
+		}
+
+		std::printf("\n%-16s %10s %10s %9s\n", "affine 3x4", "4x4 ns", "3x4 ns", "speedup");
+		double matrix = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MatrixMultiply(affineMatrices[i], affineMatrices[kDataCount - 1 - i]); });
+		double affine = MeasureNsPerOp([&](size_t i) { affineOut[i] = Multiply(affines[i], affines[kDataCount - 1 - i]); });
+		PrintResult("Multiply", matrix, affine);
+		matrix = MeasureNsPerOp([&](size_t i) { matrixOut[i] = InverseAffine(affineMatrices[i]); });
+		affine = MeasureNsPerOp([&](size_t i) { affineOut[i] = Inverse(affines[i]); });
+		PrintResult("Inverse", matrix, affine);
+		const size_t kBatch = 64;
+		matrix = MeasureNsPerOp([&](size_t i) {
+			if (i % kBatch == 0) {
+				TransformPoints(&vectors[i], kBatch, affineMatrices[0], &vectorOut[i], false);
+			}
+		});
+		affine = MeasureNsPerOp([&](size_t i) {
+			if (i % kBatch == 0) {
+				TransformPoints(&vectors[i], kBatch, affines[0], &vectorOut[i]);
+			}
+		});
+		PrintResult("TransformPoints", matrix, affine);
+
+		// 100万個の物体それぞれの行列で1点ずつ変換する（キャッシュに収まらない量）
+		const size_t kObjectCount = 1000000;
+		std::vector<Matrix4x4> objectMatrices(kObjectCount);
+		std::vector<Affine3x4> objectAffines(kObjectCount);
+		std::vector<Vector3> objectOut(kObjectCount);
+		for (size_t i = 0; i < kObjectCount; ++i) {
+			objectMatrices[i] = affineMatrices[i % kDataCount];
+			objectAffines[i] = affines[i % kDataCount];
+		}
+		const int kPasses = 10;
+		Stopwatch stopwatch;
+		for (int pass = 0; pass < kPasses; ++pass) {
+			for (size_t i = 0; i < kObjectCount; ++i) {
+				objectOut[i] = Transform(vectors[i % kDataCount], objectMatrices[i]);
+			}
+			ClobberMemory();
+		}
+		matrix = stopwatch.GetNs() / (kPasses * kObjectCount);
+		stopwatch.Restart();
+		for (int pass = 0; pass < kPasses; ++pass) {
+			for (size_t i = 0; i < kObjectCount; ++i) {
+				objectOut[i] = Transform(vectors[i % kDataCount], objectAffines[i]);
+			}
+			ClobberMemory();
+		}
+		affine = stopwatch.GetNs() / (kPasses * kObjectCount);
+		PrintResult("Transform 1M", matrix, affine);
+		gSink = affineOut[kDataCount / 2].m[0][3] + objectOut[kObjectCount / 2].x;
+	}
+
+	// 回転：オイラー角から作った回転行列とクォータニオンで、合成とベクトルの回転を比べる
+	{
+		std::vector<Matrix4x4> rotateMatrices(kDataCount);
+		std::vector<Quaternion> rotateQuaternions(kDataCount);
+		std::vector<Quaternion> quaternionOut(kDataCount);
+		for (size_t i = 0; i < kDataCount; ++i) {
+			rotateMatrices[i] = MakeRotateXMatrix(vectors[i].x) * MakeRotateYMatrix(vectors[i].y) * MakeRotateZMatrix(vectors[i].z);
+			rotateQuaternions[i] = MakeRotateQuaternion(vectors[i]);
+		}
+
+		std::printf("\n%-16s %10s %10s %9s\n", "rotation", "matrix ns", "quat ns", "speedup");
+		double matrix = MeasureNsPerOp([&](size_t i) { matrixOut[i] = MakeRotateXMatrix(vectors[i].x) * MakeRotateYMatrix(vectors[i].y) * MakeRotateZMatrix(vectors[i].z); });
+		double quaternion = MeasureNsPerOp([&](size_t i) { quaternionOut[i] = MakeRotateQuaternion(vectors[i]); });
+		PrintResult("FromEuler", matrix, quaternion);
+		matrix = MeasureNsPerOp([&](size_t i) { matrixOut[i] = rotateMatrices[i] * rotateMatrices[kDataCount - 1 - i]; });
+		quaternion = MeasureNsPerOp([&](size_t i) { quaternionOut[i] = rotateQuaternions[i] * rotateQuaternions[kDataCount - 1 - i]; });
+		PrintResult("Compose", matrix, quaternion);
+		const size_t kBatch = 64;
+		matrix = MeasureNsPerOp([&](size_t i) {
+			if (i % kBatch == 0) {
+				TransformPoints(&vectors[i], kBatch, rotateMatrices[0], &vectorOut[i]);
+			}
+		});
+		quaternion = MeasureNsPerOp([&](size_t i) {
+			if (i % kBatch == 0) {
+				RotateVectors(&vectors[i], kBatch, rotateQuaternions[0], &vectorOut[i]);
+			}
+		});
+		PrintResult("RotateVectors", matrix, quaternion);
+		gSink = quaternionOut[kDataCount / 2].w;
+	}
+
+	// SoA：Ball と同じ並びの構造体配列を1個ずつ更新する場合と、Vec3Stream でまとめて処理する場合
+	{
+		struct BallLike {
+			Vector3 position;
+			Vector3 velocity;
+			Vector3 aceleration;
+			float mass;
+			float radius;
+			unsigned int color;
+		};
+		const size_t kBallCount = 50000;
+		const int kFrames = 200;
+		const float deltaTime = 1.0f / 60.0f;
+		std::vector<BallLike> balls(kBallCount);
+		for (size_t i = 0; i < kBallCount; ++i) {
+			balls[i] = {vectors[i % kDataCount], vectors[(i * 3) % kDataCount], vectors[(i * 7) % kDataCount], 1.0f, 0.05f, 0xFFFFFFFF};
+		}
+		Vec3Stream positions;
+		Vec3Stream velocities;
+		Vec3Stream acelerations;
+		positions.Gather(balls.data(), kBallCount, &BallLike::position);
+		velocities.Gather(balls.data(), kBallCount, &BallLike::velocity);
+		acelerations.Gather(balls.data(), kBallCount, &BallLike::aceleration);
+
+		Stopwatch stopwatch;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			for (BallLike& ball : balls) {
+				ball.velocity += ball.aceleration * deltaTime;
+				ball.position += ball.velocity * deltaTime;
+			}
+			ClobberMemory();
+		}
+		double aos = stopwatch.GetNs() / (kFrames * kBallCount);
+
+		stopwatch.Restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			Axpy(deltaTime, acelerations, velocities);
+			Axpy(deltaTime, velocities, positions);
+			ClobberMemory();
+		}
+		double soa = stopwatch.GetNs() / (kFrames * kBallCount);
+
+		Vec3Stream directions;
+		stopwatch.Restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			for (size_t i = 0; i < kBallCount; ++i) {
+				vectorOut[i % kDataCount] = Normalize(balls[i].velocity);
+			}
+			ClobberMemory();
+		}
+		double aosNormalize = stopwatch.GetNs() / (kFrames * kBallCount);
+		stopwatch.Restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			Normalize(velocities, directions);
+			ClobberMemory();
+		}
+		double soaNormalize = stopwatch.GetNs() / (kFrames * kBallCount);
+
+		std::printf("\n%-16s %10s %10s %9s\n", "50k balls", "AoS ns", "SoA ns", "speedup");
+		PrintResult("Integrate", aos, soa);
+		PrintResult("Normalize", aosNormalize, soaNormalize);
+		gSink = balls[kBallCount / 2].position.x + positions.Get(kBallCount / 2).x + directions.Get(kBallCount / 2).y;
+	}
+
+	// 親子階層：毎フレーム全ノードを作り直す場合と、変更されたノードだけ更新する場合
+	{
+		const uint32_t kRootCount = 1000;
+		const uint32_t kChildrenPerRoot = 9; // 1つの親に子を9個（合計1万ノード）
+		const int kFrames = 200;
+
+		TransformHierarchy hierarchy;
+		std::vector<uint32_t> roots;
+		for (uint32_t root = 0; root < kRootCount; ++root) {
+			uint32_t parent = hierarchy.AddNode(TransformHierarchy::kNoParent, {1.0f, 1.0f, 1.0f}, vectors[root % kDataCount], vectors[(root * 3) % kDataCount]);
+			roots.push_back(parent);
+			for (uint32_t child = 0; child < kChildrenPerRoot; ++child) {
+				hierarchy.AddNode(parent, {0.5f, 0.5f, 0.5f}, vectors[(root + child) % kDataCount], vectors[(root * 5 + child) % kDataCount]);
+			}
+		}
+		hierarchy.Update();
+		uint32_t nodeCount = hierarchy.GetNodeCount();
+
+		// 従来の書き方：全ノードで MakeAffineMatrix と親との掛け算をやり直す
+		std::vector<Matrix4x4> worlds(nodeCount);
+		Stopwatch stopwatch;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			for (uint32_t node = 0; node < nodeCount; ++node) {
+				Matrix4x4 local = MakeAffineMatrix(hierarchy.GetScale(node), hierarchy.GetRotate(node), hierarchy.GetTranslate(node));
+				uint32_t parent = hierarchy.GetParent(node);
+				worlds[node] = (parent == TransformHierarchy::kNoParent) ? local : MatrixMultiply(local, worlds[parent]);
+			}
+			ClobberMemory();
+		}
+		double fullMs = stopwatch.GetMs() / kFrames;
+
+		// 1%の親だけ動かす
+		stopwatch.Restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			for (uint32_t i = 0; i < kRootCount / 100; ++i) {
+				uint32_t root = roots[(frame * 7 + i * 13) % kRootCount];
+				hierarchy.SetTranslate(root, vectors[(frame + i) % kDataCount]);
+			}
+			hierarchy.Update();
+		}
+		double partialMs = stopwatch.GetMs() / kFrames;
+		uint32_t partialUpdated = hierarchy.GetLastUpdatedCount();
+
+		// 何も動かさない
+		stopwatch.Restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			hierarchy.Update();
+		}
+		double staticMs = stopwatch.GetMs() / kFrames;
+
+		std::printf("\n%-20s %10s %10s\n", "hierarchy (10k)", "ms/frame", "updated");
+		std::printf("%-20s %10.4f %10u\n", "full recompute", fullMs, nodeCount);
+		std::printf("%-20s %10.4f %10u\n", "1% roots dirty", partialMs, partialUpdated);
+		std::printf("%-20s %10.4f %10u\n", "static", staticMs, 0u);
+		gSink = worlds[nodeCount / 2].m[3][0] + hierarchy.GetWorldMatrix(nodeCount / 2).m[3][0];
+	}
+
+	gSink = matrixOut[kDataCount / 2].m[1][2] + vectorOut[kDataCount / 2].y;
+	return 0;
+}
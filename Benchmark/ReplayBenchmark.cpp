@@ -0,0 +1,180 @@
+// 記録した描画コマンド（HeadlessApp --dump の出力）を描画側へ全速で流し、フレームレートと1フレームの時間の分布を測る。
+// シミュレーションを動かさないので、同じ記録で描画側だけを何度でも同じ条件で比べられる。
+//
+// 使い方: ReplayBenchmark 記録ファイル [--backend null|raster|raster-aa] [--loops N] [--render-thread]
+//   --backend       : 線の流し先（null は数えるだけ、raster / raster-aa は LineRasterizer で画面に描く。既定 raster）
+//   --loops         : 記録を何周流すか（既定 1）
+//   --render-thread : デコードしながら流す時間も測り、1スレッドで順に行うのと、
+//                     RenderThread で流しながら次のフレームをデコードするのを比べる
+//   フレームごとの時間はフレームを先に全部デコードしておいて測るので、デコードの時間は入らない
+#include "BenchmarkCommon.h"
+#include "DrawCommandStream.h"
+#include "LineRasterizer.h"
+#include "RenderThread.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+size_t gLineCount = 0;                   // null に流した線の数
+Framebuffer* gFramebuffer = nullptr;     // raster の描き込み先
+LineRasterizer* gRasterizer = nullptr;
+
+// 線を数えるだけ（デコード済みの線を渡す手間だけを測る）
+void CountLines(const ScreenLine*, size_t count) { gLineCount += count; }
+
+// 画面を消して描く（実際の1フレームと同じ）
+void RasterizeLines(const ScreenLine* lines, size_t count) {
+	gFramebuffer->Clear(0x000000FF);
+	gRasterizer->Rasterize(lines, count, *gFramebuffer);
+}
+
+LineFlushFunction gFlush = nullptr; // --backend で選んだ流し先
+double gFlushMs = 0.0;              // TimedFlush で流すのにかかった時間（RenderThread では描画スレッドだけが書く）
+
+void TimedFlush(const ScreenLine* lines, size_t count) {
+	Benchmark::Stopwatch stopwatch;
+	gFlush(lines, count);
+	gFlushMs += stopwatch.GetMs();
+}
+
+/// <summary>
+/// 記録を1フレームずつデコードしては流す。renderThread があれば流すのは描画スレッドに任せ、その間に次のフレームをデコードする
+/// </summary>
+/// <param name="decodeMs">デコードにかかった時間（Submit で待った時間は入らない）</param>
+/// <returns>全体の時間（ミリ秒）</returns>
+double DecodeAndFlush(DrawCommandReader& reader, size_t loops, RenderThread* renderThread, double& decodeMs) {
+	LineBatch batch(TimedFlush);
+	std::vector<ScreenLine> lines;
+	decodeMs = 0.0;
+	gFlushMs = 0.0;
+	Benchmark::Stopwatch stopwatch;
+	for (size_t loop = 0; loop < loops; ++loop) {
+		reader.Rewind();
+		Benchmark::Stopwatch decodeStopwatch;
+		while (reader.ReadFrame(lines)) {
+			for (const ScreenLine& line : lines) {
+				batch.Add(line.x1, line.y1, line.x2, line.y2, line.color);
+			}
+			decodeMs += decodeStopwatch.GetMs();
+			if (renderThread) {
+				renderThread->Submit(batch);
+			} else {
+				batch.Flush();
+			}
+			decodeStopwatch.Restart();
+		}
+	}
+	if (renderThread) {
+		renderThread->Wait();
+	}
+	return stopwatch.GetMs();
+}
+
+// 小さい順に並べた値の p パーセンタイル（最も近い順位）
+double Percentile(const std::vector<double>& sorted, double p) {
+	size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size()) + 0.5);
+	return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	const char* path = nullptr;
+	const char* backend = "raster";
+	size_t loops = 1;
+	bool compareRenderThread = false;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+			backend = argv[++i];
+		} else if (std::strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+			loops = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+		} else if (std::strcmp(argv[i], "--render-thread") == 0) {
+			compareRenderThread = true;
+		} else if (!path && argv[i][0] != '-') {
+			path = argv[i];
+		} else {
+			path = nullptr;
+			break;
+		}
+	}
+	LineFlushFunction flush = nullptr;
+	if (std::strcmp(backend, "null") == 0) {
+		flush = CountLines;
+	} else if (std::strcmp(backend, "raster") == 0 || std::strcmp(backend, "raster-aa") == 0) {
+		flush = RasterizeLines;
+	}
+	if (!path || !flush) {
+		std::fprintf(stderr, "usage: %s recording [--backend null|raster|raster-aa] [--loops N] [--render-thread]\n", argv[0]);
+		return 1;
+	}
+
+	DrawCommandReader reader;
+	if (!reader.Load(path)) {
+		std::fprintf(stderr, "cannot read %s\n", path);
+		return 1;
+	}
+	std::vector<std::vector<ScreenLine>> frames;
+	size_t lineCount = 0;
+	Benchmark::Stopwatch decodeStopwatch;
+	std::vector<ScreenLine> lines;
+	while (reader.ReadFrame(lines)) {
+		lineCount += lines.size();
+		frames.push_back(lines);
+	}
+	double decodeMs = decodeStopwatch.GetMs();
+	if (reader.HasError()) {
+		std::fprintf(stderr, "%s is broken after frame %zu\n", path, frames.size());
+		return 1;
+	}
+	if (frames.empty()) {
+		std::fprintf(stderr, "%s has no frames\n", path);
+		return 1;
+	}
+	std::printf("recording      %s (%dx%d, %zu frames, %zu lines, %zu bytes = %.2f bytes/line)\n", path, reader.GetWidth(), reader.GetHeight(), frames.size(), lineCount, reader.GetSize(),
+	            static_cast<double>(reader.GetSize()) / static_cast<double>(std::max<size_t>(1, lineCount)));
+	std::printf("decode         %.3f ms (%.1f Mlines/s)\n", decodeMs, static_cast<double>(lineCount) / (decodeMs * 1.0e3));
+
+	Framebuffer framebuffer(std::max(1, reader.GetWidth()), std::max(1, reader.GetHeight()));
+	LineRasterizer rasterizer;
+	rasterizer.SetMode(std::strcmp(backend, "raster-aa") == 0 ? LineRasterMode::kAntialiased : LineRasterMode::kAliased);
+	gFramebuffer = &framebuffer;
+	gRasterizer = &rasterizer;
+
+	// 1フレームずつ流し、それぞれの時間を取る
+	std::vector<double> frameUs;
+	frameUs.reserve(frames.size() * loops);
+	Benchmark::Stopwatch stopwatch;
+	for (size_t loop = 0; loop < loops; ++loop) {
+		for (const std::vector<ScreenLine>& frame : frames) {
+			Benchmark::Stopwatch frameStopwatch;
+			flush(frame.data(), frame.size());
+			frameUs.push_back(frameStopwatch.GetNs() * 1.0e-3);
+		}
+	}
+	double seconds = stopwatch.GetMs() * 1.0e-3;
+
+	std::sort(frameUs.begin(), frameUs.end());
+	std::printf("backend        %s (%zu loops)\n", backend, loops);
+	std::printf("time           %.3f s (%.1f fps)\n", seconds, static_cast<double>(frameUs.size()) / seconds);
+	std::printf("frame us       p50 %.2f  p90 %.2f  p99 %.2f  max %.2f\n", Percentile(frameUs, 50.0), Percentile(frameUs, 90.0), Percentile(frameUs, 99.0), frameUs.back());
+
+	if (compareRenderThread) {
+		// 重ねられた時間 = デコード + 流す時間 - 全体の時間（1スレッドなら0、理想は短いほうの時間）
+		gFlush = flush;
+		double frameCount = static_cast<double>(frames.size() * loops);
+		double decodeMs;
+		double serialMs = DecodeAndFlush(reader, loops, nullptr, decodeMs);
+		std::printf("serial         %.1f us/frame (decode %.1f + flush %.1f)\n", serialMs * 1.0e3 / frameCount, decodeMs * 1.0e3 / frameCount, gFlushMs * 1.0e3 / frameCount);
+
+		RenderThread renderThread(TimedFlush);
+		double threadedMs = DecodeAndFlush(reader, loops, &renderThread, decodeMs);
+		renderThread.Stop();
+		std::printf("render thread  %.1f us/frame (decode %.1f + flush %.1f, overlapped %.1f)\n", threadedMs * 1.0e3 / frameCount, decodeMs * 1.0e3 / frameCount, gFlushMs * 1.0e3 / frameCount,
+		            (decodeMs + gFlushMs - threadedMs) * 1.0e3 / frameCount);
+	}
+	return 0;
+}
@@ -0,0 +1,83 @@
+// ヘッドレス版のエントリーポイント。main.cpp の WinMain をそのまま呼び、フレームループを全速で回す。
+//
+// 使い方: HeadlessApp [--frames N] [--dump 出力先] [--image 出力先] [--antialias]
+//   --frames    : 回すフレーム数（既定 600）
+//   --dump      : 各フレームの線を記録ファイルに書き出す（形式は DrawCommandStream.h。ReplayBenchmark で再生できる）
+//   --image     : 最後のフレームの線を LineRasterizer で描き、PPM で書き出す（ゴールデンイメージとの比較用）
+//   --antialias : --image を Wu のアンチエイリアスで描く
+#include "HeadlessRecorder.h"
+#include "LineRasterizer.h"
+#include "Novice.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int);
+
+int main(int argc, char** argv) {
+	uint64_t frames = 600;
+	const char* dumpPath = nullptr;
+	const char* imagePath = nullptr;
+	bool antialias = false;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = std::strtoull(argv[++i], nullptr, 10);
+		} else if (std::strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+			dumpPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--image") == 0 && i + 1 < argc) {
+			imagePath = argv[++i];
+		} else if (std::strcmp(argv[i], "--antialias") == 0) {
+			antialias = true;
+		} else {
+			std::fprintf(stderr, "usage: %s [--frames N] [--dump path] [--image path] [--antialias]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (frames == 0) {
+		std::fprintf(stderr, "--frames must be at least 1\n");
+		return 1;
+	}
+
+	HeadlessRecorder::SetFrameLimit(frames);
+	if (dumpPath && !HeadlessRecorder::OpenDump(dumpPath)) {
+		std::fprintf(stderr, "cannot open %s\n", dumpPath);
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	int result = WinMain(nullptr, nullptr, nullptr, 0);
+	auto end = std::chrono::steady_clock::now();
+
+	const HeadlessRecorder::Stats& stats = HeadlessRecorder::GetStats();
+	double seconds = std::chrono::duration<double>(end - start).count();
+	double frameCount = static_cast<double>(stats.frames);
+	std::printf("frames         %llu\n", static_cast<unsigned long long>(stats.frames));
+	std::printf("time           %.3f s (%.1f fps, %.2f us/frame)\n", seconds, frameCount / seconds, seconds * 1.0e6 / frameCount);
+	std::printf("lines          %llu (%.1f/frame avg, %u max)\n", static_cast<unsigned long long>(stats.lines), static_cast<double>(stats.lines) / frameCount, stats.maxFrameLines);
+	std::printf("line bytes     %llu (%.1f/frame)\n", static_cast<unsigned long long>(stats.bytes), static_cast<double>(stats.bytes) / frameCount);
+	if (dumpPath) {
+		std::printf("dump           %s (%llu bytes)\n", dumpPath, static_cast<unsigned long long>(stats.dumpBytes));
+	}
+
+	if (imagePath) {
+		// 最後のフレームの線は次の BeginFrame まで残っている
+		const std::vector<HeadlessRecorder::Line>& lines = HeadlessRecorder::GetFrameLines();
+		int width, height;
+		HeadlessRecorder::GetScreenSize(&width, &height);
+		Framebuffer framebuffer(width, height);
+		framebuffer.Clear(BLACK);
+		LineRasterizer rasterizer;
+		rasterizer.SetMode(antialias ? LineRasterMode::kAntialiased : LineRasterMode::kAliased);
+		auto rasterStart = std::chrono::steady_clock::now();
+		rasterizer.Rasterize(lines.data(), lines.size(), framebuffer);
+		auto rasterEnd = std::chrono::steady_clock::now();
+		if (!framebuffer.WritePpm(imagePath)) {
+			std::fprintf(stderr, "cannot write %s\n", imagePath);
+			return 1;
+		}
+		std::printf("image          %s (%dx%d, %zu lines in %.3f ms)\n", imagePath, width, height, lines.size(), std::chrono::duration<double, std::milli>(rasterEnd - rasterStart).count());
+	}
+	return result;
+}
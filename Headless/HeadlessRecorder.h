@@ -0,0 +1,61 @@
+#pragma once
+// ヘッドレス版 Novice が記録した線・統計の取り出しと、記録ファイルへの書き出しの設定。
+// 記録ファイルは DrawCommandWriter で書く（形式は DrawCommandStream.h。ReplayBenchmark で再生できる）
+#include "LineBatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HeadlessRecorder {
+
+// 記録した線1本（LineRasterizer などにそのまま渡せる）
+using Line = ScreenLine;
+
+struct Stats {
+	uint64_t frames;         // 終わったフレームの数
+	uint64_t lines;          // 全フレームの線の数
+	uint64_t bytes;          // 全フレームの線のバイト数
+	uint64_t dumpBytes;      // 記録ファイルに書いたバイト数
+	uint32_t lastFrameLines; // 直前のフレームの線の数
+	uint32_t maxFrameLines;  // 1フレームの線の数の最大
+};
+
+/// <summary>
+/// このフレーム数を終えたら ProcessMessage が終了を返すようにする（0 なら終わらない）
+/// </summary>
+/// <param name="frames">フレーム数</param>
+void SetFrameLimit(uint64_t frames);
+
+/// <summary>
+/// 記録ファイルを開く（以降のフレームを EndFrame ごとに書き出す）
+/// </summary>
+/// <param name="path">出力先</param>
+/// <returns>開けたか</returns>
+bool OpenDump(const char* path);
+
+/// <summary>
+/// 記録ファイルを閉じる（Novice::Finalize でも閉じる）
+/// </summary>
+void CloseDump();
+
+/// <summary>
+/// 今のフレームの線（EndFrame のあと、次の BeginFrame までは終わったフレームの線）
+/// </summary>
+const std::vector<Line>& GetFrameLines();
+
+/// <summary>
+/// Novice::Initialize で渡された画面の大きさ
+/// </summary>
+void GetScreenSize(int* width, int* height);
+
+/// <summary>
+/// 統計
+/// </summary>
+const Stats& GetStats();
+
+/// <summary>
+/// 統計を0に戻す（計測の前にウォームアップ分を捨てるときなど）
+/// </summary>
+void ResetStats();
+
+} // namespace HeadlessRecorder
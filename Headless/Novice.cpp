@@ -0,0 +1,84 @@
+#include "Novice.h"
+#include "DrawCommandStream.h"
+#include "HeadlessRecorder.h"
+#include <cstdio>
+
+namespace {
+
+int screenWidth = 0;
+int screenHeight = 0;
+uint64_t frameLimit = 0;
+uint64_t frameCount = 0; // ResetStats の影響を受けない、終わったフレームの数
+std::vector<HeadlessRecorder::Line> frameLines; // フレームをまたいで使い回す
+HeadlessRecorder::Stats stats = {};
+DrawCommandWriter dumpWriter;
+
+} // namespace
+
+namespace Novice {
+
+void Initialize(const char*, int width, int height) {
+	screenWidth = width;
+	screenHeight = height;
+	frameLines.reserve(4096);
+}
+
+void Finalize() { HeadlessRecorder::CloseDump(); }
+
+int ProcessMessage() { return (frameLimit != 0 && frameCount >= frameLimit) ? 1 : 0; }
+
+void BeginFrame() { frameLines.clear(); }
+
+void EndFrame() {
+	uint32_t lineCount = static_cast<uint32_t>(frameLines.size());
+	frameCount++;
+	stats.frames++;
+	stats.lines += lineCount;
+	stats.bytes += lineCount * sizeof(HeadlessRecorder::Line);
+	stats.lastFrameLines = lineCount;
+	if (stats.maxFrameLines < lineCount) {
+		stats.maxFrameLines = lineCount;
+	}
+
+	if (dumpWriter.IsOpen()) {
+		uint64_t writtenBytes = dumpWriter.GetWrittenBytes();
+		dumpWriter.SetScreenSize(screenWidth, screenHeight);
+		dumpWriter.AddLines(frameLines.data(), frameLines.size());
+		dumpWriter.EndFrame();
+		stats.dumpBytes += dumpWriter.GetWrittenBytes() - writtenBytes;
+	}
+}
+
+void GetHitKeyStateAll(char* keys) { std::memset(keys, 0, 256); }
+
+void GetMousePosition(int* x, int* y) {
+	*x = 0;
+	*y = 0;
+}
+
+bool IsPressMouse(int) { return false; }
+
+void DrawLine(int x1, int y1, int x2, int y2, unsigned int color) { frameLines.push_back({x1, y1, x2, y2, color}); }
+
+} // namespace Novice
+
+namespace HeadlessRecorder {
+
+void SetFrameLimit(uint64_t frames) { frameLimit = frames; }
+
+bool OpenDump(const char* path) { return dumpWriter.Open(path); }
+
+void CloseDump() { dumpWriter.Close(); }
+
+const std::vector<Line>& GetFrameLines() { return frameLines; }
+
+void GetScreenSize(int* width, int* height) {
+	*width = screenWidth;
+	*height = screenHeight;
+}
+
+const Stats& GetStats() { return stats; }
+
+void ResetStats() { stats = {}; }
+
+} // namespace HeadlessRecorder
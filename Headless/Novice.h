@@ -0,0 +1,82 @@
+#pragma once
+// Novice のヘッドレス版。ウィンドウもGPUも使わず、描いた線をフレームごとにメモリへ記録する。
+// 本物の Novice.h と同じ名前・同じ呼び出し方なので、main.cpp をそのまま Linux でビルドして動かせる。
+// 記録した線や統計は HeadlessRecorder.h から取り出す。
+#include <cstdint>
+#include <cstring>
+
+#define WINAPI
+using HINSTANCE = void*;
+using LPSTR = char*;
+
+// キーコード（DirectInput と同じ値）
+enum {
+	DIK_ESCAPE = 0x01,
+	DIK_Q = 0x10,
+	DIK_W = 0x11,
+	DIK_E = 0x12,
+	DIK_A = 0x1E,
+	DIK_S = 0x1F,
+	DIK_D = 0x20,
+	DIK_SPACE = 0x39,
+	DIK_UP = 0xC8,
+	DIK_LEFT = 0xCB,
+	DIK_RIGHT = 0xCD,
+	DIK_DOWN = 0xD0,
+};
+
+// 色（RGBA）
+enum : unsigned int {
+	RED = 0xFF0000FF,
+	GREEN = 0x00FF00FF,
+	BLUE = 0x0000FFFF,
+	WHITE = 0xFFFFFFFF,
+	BLACK = 0x000000FF,
+};
+
+namespace Novice {
+
+/// <summary>
+/// 初期化（ウィンドウは作らず、画面サイズだけ覚える）
+/// </summary>
+/// <param name="title">ウィンドウタイトル（使わない）</param>
+/// <param name="width">画面の幅</param>
+/// <param name="height">画面の高さ</param>
+void Initialize(const char* title, int width, int height);
+
+/// <summary>
+/// 終了処理（記録ファイルを閉じる）
+/// </summary>
+void Finalize();
+
+/// <summary>
+/// メッセージ処理。HeadlessRecorder で決めたフレーム数に達したら 0 以外を返す
+/// </summary>
+int ProcessMessage();
+
+/// <summary>
+/// フレームの開始（前のフレームの線を捨てる。バッファは確保し直さない）
+/// </summary>
+void BeginFrame();
+
+/// <summary>
+/// フレームの終了（統計を更新し、記録ファイルが開いていれば書き出す）
+/// </summary>
+void EndFrame();
+
+/// <summary>
+/// 全キーの状態（ヘッドレスでは常に何も押されていない）
+/// </summary>
+/// <param name="keys">256バイトの書き込み先</param>
+void GetHitKeyStateAll(char* keys);
+
+void GetMousePosition(int* x, int* y);
+
+bool IsPressMouse(int button);
+
+/// <summary>
+/// 線を描く（今のフレームの線リストに追加する）
+/// </summary>
+void DrawLine(int x1, int y1, int x2, int y2, unsigned int color);
+
+} // namespace Novice
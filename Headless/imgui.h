@@ -0,0 +1,12 @@
+#pragma once
+// ヘッドレス版で使う ImGui の代わり。ウィンドウが無いので何も表示せず、操作も起きない。
+// main.cpp で使っている関数だけを用意する。
+
+namespace ImGui {
+
+inline bool Begin(const char*) { return false; }
+inline void End() {}
+inline bool Button(const char*) { return false; }
+inline void Text(const char*, ...) {}
+
+} // namespace ImGui
@@ -0,0 +1,120 @@
+#include "Affine3x4.h"
+#include "MathSimd.h"
+#include <assert.h>
+
+Affine3x4 Inverse(const Affine3x4& affine) {
+	const float(&m)[3][4] = affine.m;
+
+	// 3x3部分の余因子
+	float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+	float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+	float determinant = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+	assert(determinant != 0.0f);
+	float inverseDeterminant = 1.0f / determinant;
+
+	float i00 = c00 * inverseDeterminant;
+	float i01 = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inverseDeterminant;
+	float i02 = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inverseDeterminant;
+	float i10 = c01 * inverseDeterminant;
+	float i11 = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inverseDeterminant;
+	float i12 = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inverseDeterminant;
+	float i20 = c02 * inverseDeterminant;
+	float i21 = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inverseDeterminant;
+	float i22 = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inverseDeterminant;
+
+	// 平行移動は逆回転させて打ち消す（書き込んだ値を読み直さないよう、ローカル変数から計算する）
+	float tx = m[0][3];
+	float ty = m[1][3];
+	float tz = m[2][3];
+	return {
+	    i00, i01, i02, -(i00 * tx + i01 * ty + i02 * tz), i10, i11, i12, -(i10 * tx + i11 * ty + i12 * tz),
+	    i20, i21, i22, -(i20 * tx + i21 * ty + i22 * tz),
+	};
+}
+
+#if defined(MATH_SIMD_SSE)
+
+using MathSimd::LoadSoA4;
+using MathSimd::MulAdd;
+using MathSimd::StoreAoS4;
+
+Affine3x4 Multiply(const Affine3x4& lhs, const Affine3x4& rhs) {
+	// 転置した形では rhs * lhs になる。lhs の4行目は (0, 0, 0, 1)
+	const __m128 lhs0 = _mm_load_ps(lhs.m[0]);
+	const __m128 lhs1 = _mm_load_ps(lhs.m[1]);
+	const __m128 lhs2 = _mm_load_ps(lhs.m[2]);
+	const __m128 lhs3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+	Affine3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		__m128 row = _mm_mul_ps(_mm_set1_ps(rhs.m[i][3]), lhs3);
+		row = MulAdd(_mm_set1_ps(rhs.m[i][0]), lhs0, row);
+		row = MulAdd(_mm_set1_ps(rhs.m[i][1]), lhs1, row);
+		row = MulAdd(_mm_set1_ps(rhs.m[i][2]), lhs2, row);
+		_mm_store_ps(result.m[i], row);
+	}
+	return result;
+}
+
+namespace {
+
+// 4点分を変換する。kTranslate が false なら平行移動を足さない
+template<bool kTranslate> void TransformBatch(const Vector3* in, size_t count, const Affine3x4& affine, Vector3* out) {
+	__m128 m[3][4];
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			m[i][j] = _mm_set1_ps(affine.m[i][j]);
+		}
+	}
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		LoadSoA4(in + i, x, y, z);
+		__m128 result[3];
+		for (int row = 0; row < 3; ++row) {
+			__m128 sum = kTranslate ? m[row][3] : _mm_setzero_ps();
+			sum = MulAdd(x, m[row][0], sum);
+			sum = MulAdd(y, m[row][1], sum);
+			result[row] = MulAdd(z, m[row][2], sum);
+		}
+		StoreAoS4(out + i, result[0], result[1], result[2]);
+	}
+	for (; i < count; ++i) {
+		out[i] = kTranslate ? Transform(in[i], affine) : TransformNormal(in[i], affine);
+	}
+}
+
+} // namespace
+
+void TransformPoints(const Vector3* in, size_t count, const Affine3x4& affine, Vector3* out) { TransformBatch<true>(in, count, affine, out); }
+
+void TransformNormals(const Vector3* in, size_t count, const Affine3x4& affine, Vector3* out) { TransformBatch<false>(in, count, affine, out); }
+
+#else
+
+Affine3x4 Multiply(const Affine3x4& lhs, const Affine3x4& rhs) {
+	Affine3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = rhs.m[i][0] * lhs.m[0][j] + rhs.m[i][1] * lhs.m[1][j] + rhs.m[i][2] * lhs.m[2][j];
+		}
+		result.m[i][3] += rhs.m[i][3];
+	}
+	return result;
+}
+
+void TransformPoints(const Vector3* in, size_t count, const Affine3x4& affine, Vector3* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = Transform(in[i], affine);
+	}
+}
+
+void TransformNormals(const Vector3* in, size_t count, const Affine3x4& affine, Vector3* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = TransformNormal(in[i], affine);
+	}
+}
+
+#endif
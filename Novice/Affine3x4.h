@@ -0,0 +1,105 @@
+#pragma once
+#include "MathFunction.h"
+
+/// <summary>
+/// 保存用のアフィン行列（48バイト）。
+/// Matrix4x4 の最後の列は常に (0, 0, 0, 1) なので持たず、残りの4x3を転置して3行4列で持つ。
+/// m[i] = (Matrix4x4 の m[0][i], m[1][i], m[2][i], m[3][i]) なので、
+/// 変換後の成分 i は m[i] と (x, y, z, 1) の内積になる
+/// </summary>
+struct alignas(16) Affine3x4 {
+	float m[3][4];
+};
+
+/// <summary>
+/// 単位行列
+/// </summary>
+constexpr Affine3x4 MakeIdentityAffine3x4() { return {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f}; }
+
+/// <summary>
+/// Matrix4x4 から変換する（最後の列は (0, 0, 0, 1) である前提で捨てる）
+/// </summary>
+/// <param name="matrix">アフィン行列</param>
+/// <returns>48バイトのアフィン行列</returns>
+inline Affine3x4 MakeAffine3x4(const Matrix4x4& matrix) {
+	return {
+	    matrix.m[0][0], matrix.m[1][0], matrix.m[2][0], matrix.m[3][0], matrix.m[0][1], matrix.m[1][1],
+	    matrix.m[2][1], matrix.m[3][1], matrix.m[0][2], matrix.m[1][2], matrix.m[2][2], matrix.m[3][2],
+	};
+}
+
+/// <summary>
+/// Matrix4x4 に戻す（描画や射影と合成するとき用）
+/// </summary>
+/// <param name="affine">48バイトのアフィン行列</param>
+/// <returns>アフィン行列</returns>
+inline Matrix4x4 MakeMatrix4x4(const Affine3x4& affine) {
+	return {
+	    affine.m[0][0], affine.m[1][0], affine.m[2][0], 0.0f, affine.m[0][1], affine.m[1][1], affine.m[2][1], 0.0f,
+	    affine.m[0][2], affine.m[1][2], affine.m[2][2], 0.0f, affine.m[0][3], affine.m[1][3], affine.m[2][3], 1.0f,
+	};
+}
+
+/// <summary>
+/// 合成（MatrixMultiply と同じく、lhs の変換のあとに rhs の変換を行う）
+/// </summary>
+/// <param name="lhs">先に行う変換</param>
+/// <param name="rhs">後に行う変換</param>
+/// <returns>合成した変換</returns>
+Affine3x4 Multiply(const Affine3x4& lhs, const Affine3x4& rhs);
+
+/// <summary>
+/// 逆行列（3x3部分の逆行列と平行移動の打ち消しだけで求める）
+/// </summary>
+/// <param name="affine">正則なアフィン行列</param>
+/// <returns>逆行列</returns>
+Affine3x4 Inverse(const Affine3x4& affine);
+
+/// <summary>
+/// 点の変換（w による除算は行わない）
+/// </summary>
+/// <param name="point">点</param>
+/// <param name="affine">アフィン行列</param>
+/// <returns>変換後の点</returns>
+inline Vector3 Transform(const Vector3& point, const Affine3x4& affine) {
+	return {
+	    affine.m[0][0] * point.x + affine.m[0][1] * point.y + affine.m[0][2] * point.z + affine.m[0][3],
+	    affine.m[1][0] * point.x + affine.m[1][1] * point.y + affine.m[1][2] * point.z + affine.m[1][3],
+	    affine.m[2][0] * point.x + affine.m[2][1] * point.y + affine.m[2][2] * point.z + affine.m[2][3],
+	};
+}
+
+/// <summary>
+/// 方向・法線の変換（平行移動を含めない）。
+/// 非一様な拡縮を含む行列で法線を変換するときは、Inverse した行列を転置して使う
+/// </summary>
+/// <param name="normal">方向・法線</param>
+/// <param name="affine">アフィン行列</param>
+/// <returns>変換後の方向</returns>
+inline Vector3 TransformNormal(const Vector3& normal, const Affine3x4& affine) {
+	return {
+	    affine.m[0][0] * normal.x + affine.m[0][1] * normal.y + affine.m[0][2] * normal.z,
+	    affine.m[1][0] * normal.x + affine.m[1][1] * normal.y + affine.m[1][2] * normal.z,
+	    affine.m[2][0] * normal.x + affine.m[2][1] * normal.y + affine.m[2][2] * normal.z,
+	};
+}
+
+/// <summary>
+/// 複数の点をまとめて変換する（SIMDで4個ずつ処理、in と out は同じ配列でもよい）
+/// </summary>
+/// <param name="in">点の配列</param>
+/// <param name="count">個数</param>
+/// <param name="affine">アフィン行列</param>
+/// <param name="out">出力先</param>
+void TransformPoints(const Vector3* in, size_t count, const Affine3x4& affine, Vector3* out);
+
+/// <summary>
+/// 複数の方向・法線をまとめて変換する（平行移動を含めない）
+/// </summary>
+/// <param name="in">方向の配列</param>
+/// <param name="count">個数</param>
+/// <param name="affine">アフィン行列</param>
+/// <param name="out">出力先</param>
+void TransformNormals(const Vector3* in, size_t count, const Affine3x4& affine, Vector3* out);
+
+inline Affine3x4 operator*(const Affine3x4& lhs, const Affine3x4& rhs) { return Multiply(lhs, rhs); }
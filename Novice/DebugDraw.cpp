@@ -0,0 +1,637 @@
+#include "DebugDraw.h"
+#include "MathSimd.h"
+#include "Wireframe.h"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+LineDrawFunction lineDrawFunction = nullptr;
+LineBatch* lineBatch = nullptr;
+std::vector<ScreenTriangle>* triangleBatch = nullptr;
+DebugDrawStats stats = {};
+
+void DrawLine(int x1, int y1, int x2, int y2, unsigned int color) {
+	if (lineBatch) {
+		lineBatch->Add(x1, y1, x2, y2, color);
+	} else if (lineDrawFunction) {
+		lineDrawFunction(x1, y1, x2, y2, color);
+	}
+}
+
+// 同次座標の線をニアクリップ面と画面で切ってから描く
+void DrawClippedLine(const ScreenProjector& projector, const ClipVertex& a, const ClipVertex& b, uint32_t color) {
+	Vector3 screenA, screenB;
+	if (!projector.ClipLine(a, b, screenA, screenB)) {
+		++stats.rejectedLines;
+		return;
+	}
+	DrawLine(static_cast<int>(screenA.x), static_cast<int>(screenA.y), static_cast<int>(screenB.x), static_cast<int>(screenB.y), color);
+}
+
+// 同次座標の三角形をニアクリップ面とガードバンドで切り、扇形に分けてためる
+void FillClippedTriangle(const ScreenProjector& projector, const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, uint32_t color) {
+	Vector3 polygon[kMaxClippedPolygonVertices];
+	size_t count = projector.ClipTriangle(a, b, c, polygon);
+	if (count == 0) {
+		++stats.rejectedTriangles;
+		return;
+	}
+	for (size_t i = 1; i + 1 < count; ++i) {
+		triangleBatch->push_back({{polygon[0], polygon[i], polygon[i + 1]}, color});
+	}
+}
+
+// 箱の8頂点（DrawAABB と同じ並び。番号のビット0が x、ビット1が y、ビット2が z の大きい側）の6面と、面ごとの明るさ
+const int kBoxFaces[6][4] = {
+    {0, 2, 6, 4}, // -x
+    {1, 3, 7, 5}, // +x
+    {0, 1, 5, 4}, // -y
+    {2, 3, 7, 6}, // +y
+    {0, 1, 3, 2}, // -z
+    {4, 5, 7, 6}, // +z
+};
+const float kBoxFaceShade[6] = {0.8f, 0.8f, 1.0f, 1.0f, 0.6f, 0.6f};
+
+// 色の RGB に scale を掛ける（アルファはそのまま）
+uint32_t ShadeColor(uint32_t color, float scale) {
+	uint32_t result = color & 0xFF;
+	for (int shift = 8; shift < 32; shift += 8) {
+		uint32_t channel = static_cast<uint32_t>(static_cast<float>((color >> shift) & 0xFF) * scale + 0.5f);
+		result |= (std::min)(channel, 255u) << shift;
+	}
+	return result;
+}
+
+// 変換済みの箱の8頂点を、面ごとに2枚の三角形で塗る
+void FillBox(const ScreenProjector& projector, const ClipVertex* clip, uint32_t color) {
+	for (int face = 0; face < 6; ++face) {
+		const int* quad = kBoxFaces[face];
+		uint32_t faceColor = ShadeColor(color, kBoxFaceShade[face]);
+		FillClippedTriangle(projector, clip[quad[0]], clip[quad[1]], clip[quad[2]], faceColor);
+		FillClippedTriangle(projector, clip[quad[0]], clip[quad[2]], clip[quad[3]], faceColor);
+	}
+}
+
+// DrawOBB の引数から、箱の中心と半分の長さを掛けた3軸を取り出す（ワールド行列の行が各軸）
+void GetBoxAxes(const Vector3& size, const Matrix4x4& worldMatrix, Vector3& center, Vector3 (&axes)[3]) {
+	center = {worldMatrix.m[3][0], worldMatrix.m[3][1], worldMatrix.m[3][2]};
+	axes[0] = {worldMatrix.m[0][0] * size.x, worldMatrix.m[0][1] * size.x, worldMatrix.m[0][2] * size.x};
+	axes[1] = {worldMatrix.m[1][0] * size.y, worldMatrix.m[1][1] * size.y, worldMatrix.m[1][2] * size.y};
+	axes[2] = {worldMatrix.m[2][0] * size.z, worldMatrix.m[2][1] * size.z, worldMatrix.m[2][2] * size.z};
+}
+
+// 配列版の描画関数が1回にまとめて変換する箱の数
+const size_t kBoxChunk = 64;
+
+// 箱 boxCount 個分の頂点（8個ずつ）をまとめて変換して描く
+void DrawBoxBatch(const ScreenProjector& projector, const Vector3* corners, size_t boxCount, uint32_t color) {
+	ClipVertex clip[kBoxChunk * 8];
+	projector.TransformPoints(corners, boxCount * 8, clip);
+	for (size_t box = 0; box < boxCount; ++box) {
+		DrawClippedEdges(projector, clip + box * 8, kBoxEdges, 12, color);
+	}
+}
+
+// 視錐台の判定をせずに球を描く（判定は呼び出し側で行う）
+void DrawSphereWireframe(const Vector3& center, float radius, uint32_t subdivision, const ScreenProjector& projector, uint32_t color) {
+	const WireframeMesh& sphere = GetUnitSphereWireframe(subdivision);
+
+	// 中心と半径をワールド行列としてプロジェクターに合成し、単位球の頂点をそのまま1回ずつ変換する
+	const Matrix4x4 worldMatrix = {
+	    radius, 0.0f, 0.0f, 0.0f, 0.0f, radius, 0.0f, 0.0f, 0.0f, 0.0f, radius, 0.0f, center.x, center.y, center.z, 1.0f,
+	};
+	ClipVertex clip[2 + (kMaxSphereSubdivision - 1) * kMaxSphereSubdivision];
+	projector.WithWorld(worldMatrix).TransformPoints(sphere.vertices.data(), sphere.vertices.size(), clip);
+
+	for (const WireframeEdge& edge : sphere.edges) {
+		DrawClippedLine(projector, clip[edge.start], clip[edge.end], color);
+	}
+}
+
+// 視錐台の判定をせずにベジエ曲線を描く
+void DrawBezierCurve(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, uint32_t division, const ScreenProjector& projector, uint32_t color) {
+	division = std::clamp<uint32_t>(division, 1, kMaxBezierDivision);
+
+	// 曲線上の点を先に全部求めてからまとめて変換する（隣り合う線分で端点を共有）
+	Vector3 points[kMaxBezierDivision + 1];
+	for (uint32_t index = 0; index <= division; ++index) {
+		float t = static_cast<float>(index) / static_cast<float>(division);
+		points[index] = Bezier(controlPoint0, controlPoint1, controlPoint2, t);
+	}
+
+	ClipVertex clip[kMaxBezierDivision + 1];
+	projector.TransformPoints(points, division + 1, clip);
+
+	for (uint32_t index = 0; index < division; ++index) {
+		DrawClippedLine(projector, clip[index], clip[index + 1], color);
+	}
+}
+
+// 視錐台の判定結果を数える。見えないときは true を返すので、そのまま return する
+bool IsCulled(bool visible) {
+	if (visible) {
+		++stats.drawn;
+	} else {
+		++stats.culled;
+	}
+	return !visible;
+}
+
+// まとめて判定した結果を数える
+void CountCulled(size_t count, size_t visibleCount) {
+	stats.drawn += static_cast<uint32_t>(visibleCount);
+	stats.culled += static_cast<uint32_t>(count - visibleCount);
+}
+
+} // namespace
+
+const WireframeEdge kBoxEdges[12] = {
+    {0, 1},
+    {1, 3},
+    {3, 2},
+    {2, 0}, // 底面
+    {4, 5},
+    {5, 7},
+    {7, 6},
+    {6, 4}, // 上面
+    {0, 4},
+    {1, 5},
+    {2, 6},
+    {3, 7}  // 側面
+};
+
+#if defined(MATH_SIMD_SSE)
+
+// AABB の8頂点（番号のビット0が x、ビット1が y、ビット2が z の大きい側）。
+// z の小さい側の4頂点と大きい側の4頂点を、それぞれ x / y / z のレジスタで作って書き込む
+void MakeBoxCorners(const AABB& aabb, Vector3* corners) {
+	__m128 x = _mm_setr_ps(aabb.min.x, aabb.max.x, aabb.min.x, aabb.max.x);
+	__m128 y = _mm_setr_ps(aabb.min.y, aabb.min.y, aabb.max.y, aabb.max.y);
+	MathSimd::StoreAoS4(corners, x, y, _mm_set1_ps(aabb.min.z));
+	MathSimd::StoreAoS4(corners + 4, x, y, _mm_set1_ps(aabb.max.z));
+}
+
+// 中心 ± 各軸 で箱の8頂点を作る（並びは AABB と同じ）
+void MakeBoxCorners(const Vector3& center, const Vector3 (&axes)[3], Vector3* corners) {
+	using MathSimd::MulAdd;
+	const __m128 signX = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+	const __m128 signY = _mm_setr_ps(-1.0f, -1.0f, 1.0f, 1.0f);
+	// 成分ごとに、中心 ± x軸 ± y軸 の4通りを並べてから z軸を引いた側と足した側を作る
+	auto expand = [&](float c, float ax, float ay, float az, __m128& low, __m128& high) {
+		__m128 side = MulAdd(signX, _mm_set1_ps(ax), MulAdd(signY, _mm_set1_ps(ay), _mm_set1_ps(c)));
+		low = _mm_sub_ps(side, _mm_set1_ps(az));
+		high = _mm_add_ps(side, _mm_set1_ps(az));
+	};
+	__m128 x0, x1, y0, y1, z0, z1;
+	expand(center.x, axes[0].x, axes[1].x, axes[2].x, x0, x1);
+	expand(center.y, axes[0].y, axes[1].y, axes[2].y, y0, y1);
+	expand(center.z, axes[0].z, axes[1].z, axes[2].z, z0, z1);
+	MathSimd::StoreAoS4(corners, x0, y0, z0);
+	MathSimd::StoreAoS4(corners + 4, x1, y1, z1);
+}
+
+#else
+
+// AABB の8頂点（番号のビット0が x、ビット1が y、ビット2が z の大きい側）
+void MakeBoxCorners(const AABB& aabb, Vector3* corners) {
+	for (int i = 0; i < 8; ++i) {
+		corners[i] = {(i & 1) ? aabb.max.x : aabb.min.x, (i & 2) ? aabb.max.y : aabb.min.y, (i & 4) ? aabb.max.z : aabb.min.z};
+	}
+}
+
+// 中心 ± 各軸 で箱の8頂点を作る（並びは AABB と同じ）
+void MakeBoxCorners(const Vector3& center, const Vector3 (&axes)[3], Vector3* corners) {
+	for (int i = 0; i < 8; ++i) {
+		float sx = (i & 1) ? 1.0f : -1.0f;
+		float sy = (i & 2) ? 1.0f : -1.0f;
+		float sz = (i & 4) ? 1.0f : -1.0f;
+		corners[i] = {
+		    center.x + sx * axes[0].x + sy * axes[1].x + sz * axes[2].x,
+		    center.y + sx * axes[0].y + sy * axes[1].y + sz * axes[2].y,
+		    center.z + sx * axes[0].z + sy * axes[1].z + sz * axes[2].z,
+		};
+	}
+}
+
+#endif
+
+// DrawOBB の箱のワールド座標の8頂点（並びは AABB と同じ）
+void MakeBoxCorners(const Vector3& size, const Matrix4x4& worldMatrix, Vector3* corners) {
+	Vector3 center, axes[3];
+	GetBoxAxes(size, worldMatrix, center, axes);
+	MakeBoxCorners(center, axes, corners);
+}
+
+// DrawPlane / FillPlane の四角形の4頂点（周回順）
+void MakePlaneCorners(const Plane& plane, Vector3* corners) {
+	// 平面の中心点（法線方向に distance だけ離れた位置）
+	Vector3 center = {plane.normal.x * plane.distance, plane.normal.y * plane.distance, plane.normal.z * plane.distance};
+
+	// 平面と垂直な2つのベクトルを作る
+	Vector3 tangent = Normalize(Perpendicular(plane.normal));
+	Vector3 bitangent = Normalize(Cross(plane.normal, tangent));
+
+	// 大きめのサイズで四角を作成（調整可）
+	float halfSize = 2.0f;
+	corners[0] = Add(Add(center, {tangent.x * halfSize, tangent.y * halfSize, tangent.z * halfSize}), {bitangent.x * halfSize, bitangent.y * halfSize, bitangent.z * halfSize});
+	corners[1] = Add(Add(center, {-tangent.x * halfSize, -tangent.y * halfSize, -tangent.z * halfSize}), {bitangent.x * halfSize, bitangent.y * halfSize, bitangent.z * halfSize});
+	corners[2] = Add(Add(center, {-tangent.x * halfSize, -tangent.y * halfSize, -tangent.z * halfSize}), {-bitangent.x * halfSize, -bitangent.y * halfSize, -bitangent.z * halfSize});
+	corners[3] = Add(Add(center, {tangent.x * halfSize, tangent.y * halfSize, tangent.z * halfSize}), {-bitangent.x * halfSize, -bitangent.y * halfSize, -bitangent.z * halfSize});
+}
+
+void SetLineDrawFunction(LineDrawFunction function) { lineDrawFunction = function; }
+
+void SetLineBatch(LineBatch* batch) { lineBatch = batch; }
+
+void SetTriangleBatch(std::vector<ScreenTriangle>* batch) { triangleBatch = batch; }
+
+const DebugDrawStats& GetDebugDrawStats() { return stats; }
+
+void ResetDebugDrawStats() { stats = {}; }
+
+void DrawClippedEdges(const ScreenProjector& projector, const ClipVertex* clip, const WireframeEdge* edges, size_t edgeCount, uint32_t color) {
+	for (size_t i = 0; i < edgeCount; ++i) {
+		DrawClippedLine(projector, clip[edges[i].start], clip[edges[i].end], color);
+	}
+}
+
+void CountDebugDrawCulling(size_t count, size_t visibleCount) { CountCulled(count, visibleCount); }
+
+// グリッドの線の端点と色（カメラに依存しないのでコンパイル時に作っておく）
+struct GridLines {
+	static constexpr float kHalfWidth = 2.0f;
+	static constexpr uint32_t kSubdivision = 10;
+	static constexpr uint32_t kLineCount = (kSubdivision + 1) * 2; // 縦横で2本ずつ
+	Vector3 points[kLineCount * 2];                                // 1本につき始点・終点の2点
+	uint32_t colors[kLineCount];
+};
+
+constexpr GridLines MakeGridLines() {
+	const float kGridEvery = (GridLines::kHalfWidth * 2.0f) / static_cast<float>(GridLines::kSubdivision);
+
+	GridLines grid = {};
+	for (uint32_t i = 0; i <= GridLines::kSubdivision; ++i) {
+		float offset = -GridLines::kHalfWidth + i * kGridEvery;
+
+		// 色を決定（中央線だけ黒、それ以外は灰色）
+		uint32_t color = (offset == 0.0f) ? 0x000000FF : 0xAAAAAAFF;
+
+		// Z方向（X軸に平行）
+		grid.points[i * 4 + 0] = {-GridLines::kHalfWidth, 0.0f, offset};
+		grid.points[i * 4 + 1] = {GridLines::kHalfWidth, 0.0f, offset};
+		// X方向（Z軸に平行）
+		grid.points[i * 4 + 2] = {offset, 0.0f, -GridLines::kHalfWidth};
+		grid.points[i * 4 + 3] = {offset, 0.0f, GridLines::kHalfWidth};
+
+		grid.colors[i * 2 + 0] = color;
+		grid.colors[i * 2 + 1] = color;
+	}
+	return grid;
+}
+
+constexpr GridLines kGrid = MakeGridLines();
+static_assert(kGrid.colors[GridLines::kSubdivision] == 0x000000FF, "中央の線が黒になっていない");
+
+// 変換したグリッドの端点を線にして描く（カメラの後ろに回った部分は切り落とす）
+void DrawGridLines(const ScreenProjector& projector, const ClipVertex* clip) {
+	for (uint32_t line = 0; line < GridLines::kLineCount; ++line) {
+		DrawClippedLine(projector, clip[line * 2], clip[line * 2 + 1], kGrid.colors[line]);
+	}
+}
+
+void DrawGrid(const ScreenProjector& projector) {
+	if (IsCulled(IsVisible(projector.GetFrustum(), kGrid.points, GridLines::kLineCount * 2))) {
+		return;
+	}
+	ClipVertex clip[GridLines::kLineCount * 2];
+	projector.TransformPoints(kGrid.points, GridLines::kLineCount * 2, clip);
+	DrawGridLines(projector, clip);
+}
+
+void DrawSegment(const Vector3& origin, const Vector3& diff, const ScreenProjector& projector, uint32_t color) {
+	Vector3 points[2] = {origin, Add(origin, diff)};
+	if (IsCulled(IsVisible(projector.GetFrustum(), points, 2))) {
+		return;
+	}
+	ClipVertex clip[2];
+	projector.TransformPoints(points, 2, clip);
+	DrawClippedLine(projector, clip[0], clip[1], color);
+}
+
+void DrawPlane(const Plane& plane, const ScreenProjector& projector, uint32_t color) {
+	Vector3 corners[4];
+	MakePlaneCorners(plane, corners);
+
+	if (IsCulled(IsVisible(projector.GetFrustum(), corners, 4))) {
+		return;
+	}
+
+	// 画面座標に変換
+	ClipVertex clip[4];
+	projector.TransformPoints(corners, 4, clip);
+
+	// 線で四角形を描く
+	for (int i = 0; i < 4; i++) {
+		DrawClippedLine(projector, clip[i], clip[(i + 1) % 4], color);
+	}
+}
+
+void DrawTriangle(const Triangle& triangle, const ScreenProjector& projector, uint32_t color) {
+	Vector3 points[3] = {triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]};
+	if (IsCulled(IsVisible(projector.GetFrustum(), points, 3))) {
+		return;
+	}
+	ClipVertex clip[3];
+	projector.TransformPoints(points, 3, clip);
+
+	for (int i = 0; i < 3; ++i) {
+		DrawClippedLine(projector, clip[i], clip[(i + 1) % 3], color);
+	}
+}
+
+void DrawAABB(const AABB& aabb, const ScreenProjector& projector, uint32_t color) {
+	// 見えない箱は頂点を作る前に捨てる
+	if (IsCulled(IsVisible(projector.GetFrustum(), aabb))) {
+		return;
+	}
+
+	// 8頂点を求めて同次座標に変換
+	Vector3 corners[8];
+	MakeBoxCorners(aabb, corners);
+	ClipVertex clip[8];
+	projector.TransformPoints(corners, 8, clip);
+	DrawClippedEdges(projector, clip, kBoxEdges, 12, color);
+}
+
+void DrawSphere(const Vector3& center, float radius, const ScreenProjector& projector, uint32_t color) { DrawSphere(center, radius, kSphereSubdivision, projector, color); }
+
+void DrawSphere(const Vector3& center, float radius, uint32_t subdivision, const ScreenProjector& projector, uint32_t color) {
+	if (IsCulled(IsVisible(projector.GetFrustum(), Sphere{center, radius}))) {
+		return;
+	}
+	DrawSphereWireframe(center, radius, subdivision, projector, color);
+}
+
+//=== OBB描画関数 ===//
+void DrawOBB(const Vector3& size, const Matrix4x4& worldMatrix, const ScreenProjector& projector, uint32_t color) {
+	// ワールド行列の行が各軸なので、半分の長さを掛けて箱として判定する
+	Vector3 center, axes[3];
+	GetBoxAxes(size, worldMatrix, center, axes);
+	if (IsCulled(IsVisible(projector.GetFrustum(), center, axes))) {
+		return;
+	}
+
+	// 中心 ± 各軸 でワールド座標の8頂点を作ってから変換する
+	Vector3 corners[8];
+	MakeBoxCorners(center, axes, corners);
+	ClipVertex clip[8];
+	projector.TransformPoints(corners, 8, clip);
+	DrawClippedEdges(projector, clip, kBoxEdges, 12, color);
+}
+
+void DrawAABBs(const AABB* aabbs, size_t count, const ScreenProjector& projector, uint32_t color) {
+	bool visible[kBoxChunk];
+	Vector3 corners[kBoxChunk * 8];
+	for (size_t begin = 0; begin < count; begin += kBoxChunk) {
+		size_t chunk = (std::min)(kBoxChunk, count - begin);
+		CountCulled(chunk, CullAABBs(projector.GetFrustum(), aabbs + begin, chunk, visible));
+
+		// 見える箱の頂点だけを詰めて作り、まとめて変換する
+		size_t boxCount = 0;
+		for (size_t i = 0; i < chunk; ++i) {
+			if (visible[i]) {
+				MakeBoxCorners(aabbs[begin + i], corners + boxCount++ * 8);
+			}
+		}
+		DrawBoxBatch(projector, corners, boxCount, color);
+	}
+}
+
+void DrawOBBs(const OBB* obbs, size_t count, const ScreenProjector& projector, uint32_t color) {
+	bool visible[kBoxChunk];
+	Vector3 corners[kBoxChunk * 8];
+	for (size_t begin = 0; begin < count; begin += kBoxChunk) {
+		size_t chunk = (std::min)(kBoxChunk, count - begin);
+		CountCulled(chunk, CullOBBs(projector.GetFrustum(), obbs + begin, chunk, visible));
+
+		size_t boxCount = 0;
+		for (size_t i = 0; i < chunk; ++i) {
+			if (visible[i]) {
+				const OBB& obb = obbs[begin + i];
+				const Vector3 axes[3] = {Multiply(obb.size.x, obb.orientations[0]), Multiply(obb.size.y, obb.orientations[1]), Multiply(obb.size.z, obb.orientations[2])};
+				MakeBoxCorners(obb.center, axes, corners + boxCount++ * 8);
+			}
+		}
+		DrawBoxBatch(projector, corners, boxCount, color);
+	}
+}
+
+void DrawOBBs(const Vector3* sizes, const Matrix4x4* worldMatrices, size_t count, const ScreenProjector& projector, uint32_t color) {
+	OBB obbs[kBoxChunk];
+	bool visible[kBoxChunk];
+	Vector3 corners[kBoxChunk * 8];
+	for (size_t begin = 0; begin < count; begin += kBoxChunk) {
+		size_t chunk = (std::min)(kBoxChunk, count - begin);
+		// 半分の長さを掛けた軸を向きに入れ、長さを1にした OBB にして CullOBBs でまとめて判定する
+		for (size_t i = 0; i < chunk; ++i) {
+			GetBoxAxes(sizes[begin + i], worldMatrices[begin + i], obbs[i].center, obbs[i].orientations);
+			obbs[i].size = {1.0f, 1.0f, 1.0f};
+		}
+		CountCulled(chunk, CullOBBs(projector.GetFrustum(), obbs, chunk, visible));
+
+		size_t boxCount = 0;
+		for (size_t i = 0; i < chunk; ++i) {
+			if (visible[i]) {
+				MakeBoxCorners(obbs[i].center, obbs[i].orientations, corners + boxCount++ * 8);
+			}
+		}
+		DrawBoxBatch(projector, corners, boxCount, color);
+	}
+}
+
+void DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const ScreenProjector& projector, uint32_t color) {
+	DrawBezier(controlPoint0, controlPoint1, controlPoint2, kBezierDivision, projector, color);
+}
+
+void DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, uint32_t division, const ScreenProjector& projector, uint32_t color) {
+	// 曲線は制御点の凸包に収まるので、制御点で判定する
+	const Vector3 controlPoints[3] = {controlPoint0, controlPoint1, controlPoint2};
+	if (IsCulled(IsVisible(projector.GetFrustum(), controlPoints, 3))) {
+		return;
+	}
+	DrawBezierCurve(controlPoint0, controlPoint1, controlPoint2, division, projector, color);
+}
+
+void DrawSphereLod(const Vector3& center, float radius, const ScreenProjector& projector, uint32_t color, uint32_t& subdivision) {
+	// 見えない間は分割数を選び直さない
+	if (IsCulled(IsVisible(projector.GetFrustum(), Sphere{center, radius}))) {
+		return;
+	}
+	subdivision = SelectSphereSubdivision(projector.GetProjectedRadius(center, radius), subdivision);
+	DrawSphereWireframe(center, radius, subdivision, projector, color);
+}
+
+void DrawBezierLod(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const ScreenProjector& projector, uint32_t color, uint32_t& division) {
+	// 制御点の折れ線の画面上の長さ（カメラの後ろに回った制御点があれば最大の分割数にする）
+	Vector3 controlPoints[3] = {controlPoint0, controlPoint1, controlPoint2};
+	if (IsCulled(IsVisible(projector.GetFrustum(), controlPoints, 3))) {
+		return;
+	}
+	bool visible[3];
+	float length = std::numeric_limits<float>::infinity();
+	if (projector.ProjectPoints(controlPoints, 3, controlPoints, visible) == 3) {
+		auto screenLength = [](const Vector3& a, const Vector3& b) { return std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y)); };
+		length = screenLength(controlPoints[0], controlPoints[1]) + screenLength(controlPoints[1], controlPoints[2]);
+	}
+	division = SelectBezierDivision(length, division);
+	DrawBezierCurve(controlPoint0, controlPoint1, controlPoint2, division, projector, color);
+}
+
+void FillTriangle(const Triangle& triangle, const ScreenProjector& projector, uint32_t color) {
+	if (!triangleBatch || IsCulled(IsVisible(projector.GetFrustum(), triangle.vertices, 3))) {
+		return;
+	}
+	ClipVertex clip[3];
+	projector.TransformPoints(triangle.vertices, 3, clip);
+	FillClippedTriangle(projector, clip[0], clip[1], clip[2], color);
+}
+
+void FillPlane(const Plane& plane, const ScreenProjector& projector, uint32_t color) {
+	if (!triangleBatch) {
+		return;
+	}
+	Vector3 corners[4];
+	MakePlaneCorners(plane, corners);
+	if (IsCulled(IsVisible(projector.GetFrustum(), corners, 4))) {
+		return;
+	}
+	ClipVertex clip[4];
+	projector.TransformPoints(corners, 4, clip);
+	FillClippedTriangle(projector, clip[0], clip[1], clip[2], color);
+	FillClippedTriangle(projector, clip[0], clip[2], clip[3], color);
+}
+
+void FillAABB(const AABB& aabb, const ScreenProjector& projector, uint32_t color) {
+	if (!triangleBatch || IsCulled(IsVisible(projector.GetFrustum(), aabb))) {
+		return;
+	}
+	Vector3 corners[8];
+	MakeBoxCorners(aabb, corners);
+	ClipVertex clip[8];
+	projector.TransformPoints(corners, 8, clip);
+	FillBox(projector, clip, color);
+}
+
+void FillOBB(const Vector3& size, const Matrix4x4& worldMatrix, const ScreenProjector& projector, uint32_t color) {
+	if (!triangleBatch) {
+		return;
+	}
+	Vector3 center, axes[3];
+	GetBoxAxes(size, worldMatrix, center, axes);
+	if (IsCulled(IsVisible(projector.GetFrustum(), center, axes))) {
+		return;
+	}
+	Vector3 corners[8];
+	MakeBoxCorners(center, axes, corners);
+	ClipVertex clip[8];
+	projector.TransformPoints(corners, 8, clip);
+	FillBox(projector, clip, color);
+}
+
+uint32_t AddStaticPlane(ProjectionCache& cache, const Plane& plane) {
+	Vector3 corners[4];
+	MakePlaneCorners(plane, corners);
+	return cache.AddShape(corners, 4);
+}
+
+uint32_t AddStaticGrid(ProjectionCache& cache) { return cache.AddShape(kGrid.points, GridLines::kLineCount * 2); }
+
+uint32_t AddStaticAABB(ProjectionCache& cache, const AABB& aabb) {
+	Vector3 corners[8];
+	MakeBoxCorners(aabb, corners);
+	return cache.AddShape(corners, 8);
+}
+
+uint32_t AddStaticOBB(ProjectionCache& cache, const Vector3& size, const Matrix4x4& worldMatrix) {
+	Vector3 corners[8];
+	MakeBoxCorners(size, worldMatrix, corners);
+	return cache.AddShape(corners, 8);
+}
+
+void SetStaticPlane(ProjectionCache& cache, uint32_t shape, const Plane& plane) {
+	assert(cache.GetPointCount(shape) == 4);
+	Vector3 corners[4];
+	MakePlaneCorners(plane, corners);
+	cache.SetPoints(shape, corners);
+}
+
+void SetStaticAABB(ProjectionCache& cache, uint32_t shape, const AABB& aabb) {
+	assert(cache.GetPointCount(shape) == 8);
+	Vector3 corners[8];
+	MakeBoxCorners(aabb, corners);
+	cache.SetPoints(shape, corners);
+}
+
+void SetStaticOBB(ProjectionCache& cache, uint32_t shape, const Vector3& size, const Matrix4x4& worldMatrix) {
+	assert(cache.GetPointCount(shape) == 8);
+	Vector3 corners[8];
+	MakeBoxCorners(size, worldMatrix, corners);
+	cache.SetPoints(shape, corners);
+}
+
+void DrawStaticPlane(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color) {
+	assert(cache.GetPointCount(shape) == 4);
+	const ClipVertex* clip = cache.Project(shape, projector);
+	if (IsCulled(clip != nullptr)) {
+		return;
+	}
+	for (int i = 0; i < 4; i++) {
+		DrawClippedLine(projector, clip[i], clip[(i + 1) % 4], color);
+	}
+}
+
+void DrawStaticGrid(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector) {
+	assert(cache.GetPointCount(shape) == GridLines::kLineCount * 2);
+	const ClipVertex* clip = cache.Project(shape, projector);
+	if (IsCulled(clip != nullptr)) {
+		return;
+	}
+	DrawGridLines(projector, clip);
+}
+
+void DrawStaticBox(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color) {
+	assert(cache.GetPointCount(shape) == 8);
+	const ClipVertex* clip = cache.Project(shape, projector);
+	if (IsCulled(clip != nullptr)) {
+		return;
+	}
+	DrawClippedEdges(projector, clip, kBoxEdges, 12, color);
+}
+
+void FillStaticPlane(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color) {
+	assert(cache.GetPointCount(shape) == 4);
+	if (!triangleBatch) {
+		return;
+	}
+	const ClipVertex* clip = cache.Project(shape, projector);
+	if (IsCulled(clip != nullptr)) {
+		return;
+	}
+	FillClippedTriangle(projector, clip[0], clip[1], clip[2], color);
+	FillClippedTriangle(projector, clip[0], clip[2], clip[3], color);
+}
+
+void FillStaticBox(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color) {
+	assert(cache.GetPointCount(shape) == 8);
+	if (!triangleBatch) {
+		return;
+	}
+	const ClipVertex* clip = cache.Project(shape, projector);
+	if (IsCulled(clip != nullptr)) {
+		return;
+	}
+	FillBox(projector, clip, color);
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include "Geometry.h"
+#include "LineBatch.h"
+#include "Lod.h"
+#include "ProjectionCache.h"
+#include "ScreenProjector.h"
+#include "TriangleRasterizer.h"
+#include "Wireframe.h"
+#include <cstdint>
+#include <vector>
+
+// 線を1本描く関数（Novice::DrawLine と同じ形）
+using LineDrawFunction = void (*)(int x1, int y1, int x2, int y2, unsigned int color);
+
+/// <summary>
+/// 下の描画関数が線を出力する先を設定する（ゲームでは Novice::DrawLine を渡す。nullptr なら何も描かない）
+/// </summary>
+/// <param name="function">線を描く関数</param>
+void SetLineDrawFunction(LineDrawFunction function);
+
+/// <summary>
+/// 下の描画関数の線を1本ずつ描かずに batch にためるようにする（nullptr で SetLineDrawFunction の関数に戻す）。
+/// ためた線はフレームの最後に batch.Flush() でまとめて描く
+/// </summary>
+/// <param name="batch">線をためる先</param>
+void SetLineBatch(LineBatch* batch);
+
+/// <summary>
+/// 下の Fill* 関数が三角形をためる先を設定する（nullptr なら何も塗らない）。
+/// ためた三角形はフレームの最後に TriangleRasterizer でまとめて描き、空にする
+/// </summary>
+/// <param name="batch">三角形をためる先</param>
+void SetTriangleBatch(std::vector<ScreenTriangle>* batch);
+
+// 描画関数が視錐台で判定した結果の数
+struct DebugDrawStats {
+	uint32_t drawn;             // 描いた図形の数
+	uint32_t culled;            // 見えないので捨てた図形の数
+	uint32_t rejectedLines;     // 描いた図形のうち、画面に映らないので捨てた線の数
+	uint32_t rejectedTriangles; // 塗った図形のうち、画面に映らないので捨てた三角形の数
+};
+
+/// <summary>
+/// ResetDebugDrawStats からの判定結果の数（毎フレームの初めに Reset する）
+/// </summary>
+const DebugDrawStats& GetDebugDrawStats();
+
+void ResetDebugDrawStats();
+
+/// <summary>
+/// グリッド描画関数（毎回変換する。カメラが動くまで変換した頂点を使い回すなら AddStaticGrid / DrawStaticGrid を使う）
+/// </summary>
+/// <param name="projector">スクリーン座標への変換</param>
+void DrawGrid(const ScreenProjector& projector);
+
+/// <summary>
+/// 線分描画関数
+/// </summary>
+/// <param name="origin">始点</param>
+/// <param name="diff">終点への差分ベクトル</param>
+/// <param name="projector">スクリーン座標への変換</param>
+/// <param name="color">色</param>
+void DrawSegment(const Vector3& origin, const Vector3& diff, const ScreenProjector& projector, uint32_t color);
+
+void DrawPlane(const Plane& plane, const ScreenProjector& projector, uint32_t color);
+
+void DrawTriangle(const Triangle& triangle, const ScreenProjector& projector, uint32_t color);
+
+void DrawAABB(const AABB& aabb, const ScreenProjector& projector, uint32_t color);
+
+/// <summary>
+/// スフィア描画関数
+/// </summary>
+/// <param name="center">中心座標</param>
+/// <param name="radius">半径</param>
+/// <param name="projector">スクリーン座標への変換</param>
+/// <param name="color">色</param>
+void DrawSphere(const Vector3& center, float radius, const ScreenProjector& projector, uint32_t color);
+
+// DrawSphere の既定の分割数
+const uint32_t kSphereSubdivision = 10;
+
+/// <summary>
+/// 分割数を指定するスフィア描画関数（単位球のワイヤーフレームを使い回す）
+/// </summary>
+/// <param name="center">中心座標</param>
+/// <param name="radius">半径</param>
+/// <param name="subdivision">緯度・経度の分割数（1以上 kMaxSphereSubdivision 以下）</param>
+/// <param name="projector">スクリーン座標への変換</param>
+/// <param name="color">色</param>
+void DrawSphere(const Vector3& center, float radius, uint32_t subdivision, const ScreenProjector& projector, uint32_t color);
+
+//=== OBB描画関数 ===//
+void DrawOBB(const Vector3& size, const Matrix4x4& worldMatrix, const ScreenProjector& projector, uint32_t color);
+
+//=== 箱をまとめて描く（視錐台の判定と頂点の変換を配列ごとに行う。大量の箱を同じ色で描くとき用） ===//
+
+/// <summary>
+/// AABB の配列を描く
+/// </summary>
+/// <param name="aabbs">箱の配列</param>
+/// <param name="count">箱の数</param>
+/// <param name="projector">スクリーン座標への変換</param>
+/// <param name="color">色</param>
+void DrawAABBs(const AABB* aabbs, size_t count, const ScreenProjector& projector, uint32_t color);
+
+/// <summary>
+/// OBB の配列を描く
+/// </summary>
+void DrawOBBs(const OBB* obbs, size_t count, const ScreenProjector& projector, uint32_t color);
+
+/// <summary>
+/// DrawOBB の配列版
+/// </summary>
+/// <param name="sizes">箱ごとの半分の大きさ</param>
+/// <param name="worldMatrices">箱ごとのワールド行列</param>
+/// <param name="count">箱の数</param>
+void DrawOBBs(const Vector3* sizes, const Matrix4x4* worldMatrices, size_t count, const ScreenProjector& projector, uint32_t color);
+
+void DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const ScreenProjector& projector, uint32_t color);
+
+// DrawBezier の既定の分割数
+const uint32_t kBezierDivision = 32;
+
+/// <summary>
+/// 分割数を指定するベジエ曲線描画関数
+/// </summary>
+/// <param name="division">分割数（1以上 kMaxBezierDivision 以下）</param>
+void DrawBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, uint32_t division, const ScreenProjector& projector, uint32_t color);
+
+//=== 画面上の大きさで分割数を変える描画関数（設定は SetLodSettings） ===//
+
+/// <summary>
+/// 画面上の半径から分割数を選んでスフィアを描く
+/// </summary>
+/// <param name="center">中心座標</param>
+/// <param name="radius">半径</param>
+/// <param name="projector">スクリーン座標への変換</param>
+/// <param name="color">色</param>
+/// <param name="subdivision">前のフレームの分割数（初めは0）。選んだ分割数に書き換わる</param>
+void DrawSphereLod(const Vector3& center, float radius, const ScreenProjector& projector, uint32_t color, uint32_t& subdivision);
+
+/// <summary>
+/// 制御点の折れ線の画面上の長さから分割数を選んでベジエ曲線を描く
+/// </summary>
+/// <param name="division">前のフレームの分割数（初めは0）。選んだ分割数に書き換わる</param>
+void DrawBezierLod(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, const ScreenProjector& projector, uint32_t color, uint32_t& division);
+
+//=== 塗りつぶし（SetTriangleBatch の先に三角形をためる。ニアクリップ面で切り、深度テストは TriangleRasterizer で行う） ===//
+
+void FillTriangle(const Triangle& triangle, const ScreenProjector& projector, uint32_t color);
+
+/// <summary>
+/// DrawPlane と同じ四角形を塗る
+/// </summary>
+void FillPlane(const Plane& plane, const ScreenProjector& projector, uint32_t color);
+
+/// <summary>
+/// 箱を塗る（形がわかるよう、面の向きごとに明るさを変える）
+/// </summary>
+void FillAABB(const AABB& aabb, const ScreenProjector& projector, uint32_t color);
+
+/// <summary>
+/// 箱を塗る（DrawOBB と同じ引数。面の向きごとに明るさを変える）
+/// </summary>
+void FillOBB(const Vector3& size, const Matrix4x4& worldMatrix, const ScreenProjector& projector, uint32_t color);
+
+//=== 動かない図形（頂点を ProjectionCache に登録しておき、カメラか形が変わるまで変換し直さない） ===//
+
+/// <summary>
+/// DrawPlane と同じ四角形を cache に登録する
+/// </summary>
+/// <returns>図形の番号（DrawStaticPlane / FillStaticPlane に渡す）</returns>
+uint32_t AddStaticPlane(ProjectionCache& cache, const Plane& plane);
+
+/// <summary>
+/// DrawGrid と同じグリッドを cache に登録する
+/// </summary>
+/// <returns>図形の番号（DrawStaticGrid に渡す）</returns>
+uint32_t AddStaticGrid(ProjectionCache& cache);
+
+/// <summary>
+/// 箱を cache に登録する
+/// </summary>
+/// <returns>図形の番号（DrawStaticBox / FillStaticBox に渡す）</returns>
+uint32_t AddStaticAABB(ProjectionCache& cache, const AABB& aabb);
+
+/// <summary>
+/// DrawOBB と同じ箱を cache に登録する
+/// </summary>
+/// <returns>図形の番号（DrawStaticBox / FillStaticBox に渡す）</returns>
+uint32_t AddStaticOBB(ProjectionCache& cache, const Vector3& size, const Matrix4x4& worldMatrix);
+
+// 登録した図形の形を変える（次に描くときだけ変換し直す）
+void SetStaticPlane(ProjectionCache& cache, uint32_t shape, const Plane& plane);
+void SetStaticAABB(ProjectionCache& cache, uint32_t shape, const AABB& aabb);
+void SetStaticOBB(ProjectionCache& cache, uint32_t shape, const Vector3& size, const Matrix4x4& worldMatrix);
+
+void DrawStaticGrid(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector);
+
+void DrawStaticPlane(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color);
+
+void DrawStaticBox(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color);
+
+void FillStaticPlane(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color);
+
+void FillStaticBox(ProjectionCache& cache, uint32_t shape, const ScreenProjector& projector, uint32_t color);
+
+//=== 図形の頂点と、変換した頂点の描画（DebugScene のように頂点を覚えておいて描くとき用） ===//
+
+// MakeBoxCorners の8頂点を結ぶ12本の辺
+extern const WireframeEdge kBoxEdges[12];
+
+/// <summary>
+/// AABB の8頂点（番号のビット0が x、ビット1が y、ビット2が z の大きい側）
+/// </summary>
+void MakeBoxCorners(const AABB& aabb, Vector3* corners);
+
+/// <summary>
+/// 中心 ± 各軸 で箱の8頂点を作る（並びは AABB と同じ）
+/// </summary>
+/// <param name="axes">半分の長さを掛けた3軸</param>
+void MakeBoxCorners(const Vector3& center, const Vector3 (&axes)[3], Vector3* corners);
+
+/// <summary>
+/// DrawOBB と同じ箱のワールド座標の8頂点（並びは AABB と同じ）
+/// </summary>
+void MakeBoxCorners(const Vector3& size, const Matrix4x4& worldMatrix, Vector3* corners);
+
+/// <summary>
+/// DrawPlane と同じ四角形の4頂点（周回順）
+/// </summary>
+void MakePlaneCorners(const Plane& plane, Vector3* corners);
+
+/// <summary>
+/// 変換した頂点を辺でつないで描く（ニアクリップ面とガードバンドで切り、映らない線は rejectedLines に数える）
+/// </summary>
+/// <param name="projector">clip を求めたプロジェクター</param>
+/// <param name="clip">TransformPoints で変換した頂点</param>
+/// <param name="edges">辺（clip の番号）</param>
+/// <param name="edgeCount">辺の数</param>
+/// <param name="color">色</param>
+void DrawClippedEdges(const ScreenProjector& projector, const ClipVertex* clip, const WireframeEdge* edges, size_t edgeCount, uint32_t color);
+
+/// <summary>
+/// まとめて視錐台で判定した結果を GetDebugDrawStats の drawn / culled に足す
+/// </summary>
+void CountDebugDrawCulling(size_t count, size_t visibleCount);
@@ -0,0 +1,376 @@
+#include "DebugScene.h"
+#include "DebugDraw.h"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 1回の CullSpheres で判定する図形の数
+const size_t kCullChunk = 256;
+
+// 番号の下位32ビットが表の場所、上位32ビットが世代
+const uint32_t kHandleIndexBits = 32;
+
+// 頂点を全部囲む球（頂点の範囲の中心から一番遠い頂点まで）
+Sphere MakeBoundingSphere(const Vector3* points, size_t count) {
+	Vector3 minPoint = points[0];
+	Vector3 maxPoint = points[0];
+	for (size_t i = 1; i < count; ++i) {
+		minPoint = {(std::min)(minPoint.x, points[i].x), (std::min)(minPoint.y, points[i].y), (std::min)(minPoint.z, points[i].z)};
+		maxPoint = {(std::max)(maxPoint.x, points[i].x), (std::max)(maxPoint.y, points[i].y), (std::max)(maxPoint.z, points[i].z)};
+	}
+	Vector3 center = {(minPoint.x + maxPoint.x) * 0.5f, (minPoint.y + maxPoint.y) * 0.5f, (minPoint.z + maxPoint.z) * 0.5f};
+	float radiusSquared = 0.0f;
+	for (size_t i = 0; i < count; ++i) {
+		Vector3 d = {points[i].x - center.x, points[i].y - center.y, points[i].z - center.z};
+		radiusSquared = (std::max)(radiusSquared, d.x * d.x + d.y * d.y + d.z * d.z);
+	}
+	return {center, std::sqrt(radiusSquared)};
+}
+
+// points を周回順につなぐ辺
+std::vector<WireframeEdge> MakeLoopEdges(uint16_t count) {
+	std::vector<WireframeEdge> edges;
+	for (uint16_t i = 0; i < count; ++i) {
+		edges.push_back({i, static_cast<uint16_t>((i + 1) % count)});
+	}
+	return edges;
+}
+
+Vector3 LoadVector3(const float* f) { return {f[0], f[1], f[2]}; }
+
+} // namespace
+
+DebugScene::DebugScene() {
+	const WireframeMesh& sphere = GetUnitSphereWireframe(kSphereSubdivision);
+	pools_[kSphere].paramCount = 4; // 中心・半径
+	pools_[kSphere].pointCount = static_cast<uint32_t>(sphere.vertices.size());
+	pools_[kSphere].edges = sphere.edges;
+
+	pools_[kSegment].paramCount = 6; // 始点・差分
+	pools_[kSegment].pointCount = 2;
+	pools_[kSegment].edges = {{0, 1}};
+
+	pools_[kAABB].paramCount = 6; // 最小点・最大点
+	pools_[kAABB].pointCount = 8;
+	pools_[kAABB].edges.assign(kBoxEdges, kBoxEdges + 12);
+
+	pools_[kOBB].paramCount = 3 + 16; // 半分の大きさ・ワールド行列
+	pools_[kOBB].pointCount = 8;
+	pools_[kOBB].edges.assign(kBoxEdges, kBoxEdges + 12);
+
+	pools_[kPlane].paramCount = 4; // 法線・距離
+	pools_[kPlane].pointCount = 4;
+	pools_[kPlane].edges = MakeLoopEdges(4);
+
+	pools_[kTriangle].paramCount = 9; // 3頂点
+	pools_[kTriangle].pointCount = 3;
+	pools_[kTriangle].edges = MakeLoopEdges(3);
+
+	pools_[kBezier].paramCount = 9; // 3つの制御点
+	pools_[kBezier].pointCount = kBezierDivision + 1;
+	for (uint16_t i = 0; i < kBezierDivision; ++i) {
+		pools_[kBezier].edges.push_back({i, static_cast<uint16_t>(i + 1)});
+	}
+}
+
+DebugShapeHandle DebugScene::AddSphere(const Vector3& center, float radius, uint32_t color, uint32_t lifetime) {
+	const float params[4] = {center.x, center.y, center.z, radius};
+	return Add(kSphere, params, color, lifetime);
+}
+
+DebugShapeHandle DebugScene::AddSegment(const Vector3& origin, const Vector3& diff, uint32_t color, uint32_t lifetime) {
+	const float params[6] = {origin.x, origin.y, origin.z, diff.x, diff.y, diff.z};
+	return Add(kSegment, params, color, lifetime);
+}
+
+DebugShapeHandle DebugScene::AddAABB(const AABB& aabb, uint32_t color, uint32_t lifetime) {
+	const float params[6] = {aabb.min.x, aabb.min.y, aabb.min.z, aabb.max.x, aabb.max.y, aabb.max.z};
+	return Add(kAABB, params, color, lifetime);
+}
+
+DebugShapeHandle DebugScene::AddOBB(const Vector3& size, const Matrix4x4& worldMatrix, uint32_t color, uint32_t lifetime) {
+	float params[19] = {size.x, size.y, size.z};
+	std::memcpy(params + 3, worldMatrix.m, sizeof(worldMatrix.m));
+	return Add(kOBB, params, color, lifetime);
+}
+
+DebugShapeHandle DebugScene::AddPlane(const Plane& plane, uint32_t color, uint32_t lifetime) {
+	const float params[4] = {plane.normal.x, plane.normal.y, plane.normal.z, plane.distance};
+	return Add(kPlane, params, color, lifetime);
+}
+
+DebugShapeHandle DebugScene::AddTriangle(const Triangle& triangle, uint32_t color, uint32_t lifetime) {
+	const Vector3* v = triangle.vertices;
+	const float params[9] = {v[0].x, v[0].y, v[0].z, v[1].x, v[1].y, v[1].z, v[2].x, v[2].y, v[2].z};
+	return Add(kTriangle, params, color, lifetime);
+}
+
+DebugShapeHandle DebugScene::AddBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, uint32_t color, uint32_t lifetime) {
+	const float params[9] = {
+	    controlPoint0.x, controlPoint0.y, controlPoint0.z, controlPoint1.x, controlPoint1.y, controlPoint1.z, controlPoint2.x, controlPoint2.y, controlPoint2.z,
+	};
+	return Add(kBezier, params, color, lifetime);
+}
+
+void DebugScene::SetSphere(DebugShapeHandle shape, const Vector3& center, float radius) {
+	const float params[4] = {center.x, center.y, center.z, radius};
+	Set(shape, kSphere, params);
+}
+
+void DebugScene::SetSegment(DebugShapeHandle shape, const Vector3& origin, const Vector3& diff) {
+	const float params[6] = {origin.x, origin.y, origin.z, diff.x, diff.y, diff.z};
+	Set(shape, kSegment, params);
+}
+
+void DebugScene::SetAABB(DebugShapeHandle shape, const AABB& aabb) {
+	const float params[6] = {aabb.min.x, aabb.min.y, aabb.min.z, aabb.max.x, aabb.max.y, aabb.max.z};
+	Set(shape, kAABB, params);
+}
+
+void DebugScene::SetOBB(DebugShapeHandle shape, const Vector3& size, const Matrix4x4& worldMatrix) {
+	float params[19] = {size.x, size.y, size.z};
+	std::memcpy(params + 3, worldMatrix.m, sizeof(worldMatrix.m));
+	Set(shape, kOBB, params);
+}
+
+void DebugScene::SetPlane(DebugShapeHandle shape, const Plane& plane) {
+	const float params[4] = {plane.normal.x, plane.normal.y, plane.normal.z, plane.distance};
+	Set(shape, kPlane, params);
+}
+
+void DebugScene::SetTriangle(DebugShapeHandle shape, const Triangle& triangle) {
+	const Vector3* v = triangle.vertices;
+	const float params[9] = {v[0].x, v[0].y, v[0].z, v[1].x, v[1].y, v[1].z, v[2].x, v[2].y, v[2].z};
+	Set(shape, kTriangle, params);
+}
+
+void DebugScene::SetBezier(DebugShapeHandle shape, const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2) {
+	const float params[9] = {
+	    controlPoint0.x, controlPoint0.y, controlPoint0.z, controlPoint1.x, controlPoint1.y, controlPoint1.z, controlPoint2.x, controlPoint2.y, controlPoint2.z,
+	};
+	Set(shape, kBezier, params);
+}
+
+void DebugScene::SetColor(DebugShapeHandle shape, uint32_t color) {
+	if (const HandleEntry* entry = Find(shape)) {
+		pools_[entry->type].colors[entry->slot] = color;
+	}
+}
+
+void DebugScene::SetLifetime(DebugShapeHandle shape, uint32_t lifetime) {
+	if (const HandleEntry* entry = Find(shape)) {
+		pools_[entry->type].lifetimes[entry->slot] = (std::max)(lifetime, 1u);
+	}
+}
+
+void DebugScene::Remove(DebugShapeHandle shape) {
+	if (const HandleEntry* entry = Find(shape)) {
+		RemoveSlot(static_cast<ShapeType>(entry->type), entry->slot);
+	}
+}
+
+bool DebugScene::IsAlive(DebugShapeHandle shape) const { return Find(shape) != nullptr; }
+
+void DebugScene::Clear() {
+	for (uint32_t type = 0; type < kShapeTypeCount; ++type) {
+		Pool& pool = pools_[type];
+		while (pool.GetCount() > 0) {
+			RemoveSlot(static_cast<ShapeType>(type), static_cast<uint32_t>(pool.GetCount() - 1));
+		}
+	}
+}
+
+void DebugScene::Update() {
+	for (uint32_t type = 0; type < kShapeTypeCount; ++type) {
+		Pool& pool = pools_[type];
+		// 後ろから見るので、消した場所に移ってくる図形は見終わったものになる
+		for (size_t slot = pool.GetCount(); slot-- > 0;) {
+			uint32_t& lifetime = pool.lifetimes[slot];
+			if (lifetime != kDebugShapeForever && --lifetime == 0) {
+				RemoveSlot(static_cast<ShapeType>(type), static_cast<uint32_t>(slot));
+			}
+		}
+	}
+}
+
+void DebugScene::Draw(const ScreenProjector& projector) {
+	lastTessellatedCount_ = 0;
+	lastTransformedCount_ = 0;
+
+	for (uint32_t type = 0; type < kShapeTypeCount; ++type) {
+		Pool& pool = pools_[type];
+		const size_t count = pool.GetCount();
+
+		for (size_t slot = 0; slot < count; ++slot) {
+			if (pool.dirty[slot]) {
+				Tessellate(static_cast<ShapeType>(type), static_cast<uint32_t>(slot));
+				++lastTessellatedCount_;
+			}
+		}
+
+		pool.shapes.ResetStats();
+		bool visible[kCullChunk];
+		for (size_t begin = 0; begin < count; begin += kCullChunk) {
+			size_t chunk = (std::min)(kCullChunk, count - begin);
+			CountDebugDrawCulling(chunk, CullSpheres(projector.GetFrustum(), pool.bounds.data() + begin, chunk, visible));
+			pool.shapes.ProjectShapes(static_cast<uint32_t>(begin), static_cast<uint32_t>(chunk), projector, visible);
+
+			for (size_t i = 0; i < chunk; ++i) {
+				if (visible[i]) {
+					size_t slot = begin + i;
+					DrawClippedEdges(projector, pool.shapes.GetClip(static_cast<uint32_t>(slot)), pool.edges.data(), pool.edges.size(), pool.colors[slot]);
+				}
+			}
+		}
+		lastTransformedCount_ += static_cast<uint32_t>(pool.shapes.GetTransformedCount());
+	}
+}
+
+size_t DebugScene::GetShapeCount() const {
+	size_t count = 0;
+	for (const Pool& pool : pools_) {
+		count += pool.GetCount();
+	}
+	return count;
+}
+
+DebugShapeHandle DebugScene::Add(ShapeType type, const float* params, uint32_t color, uint32_t lifetime) {
+	Pool& pool = pools_[type];
+	uint32_t slot = static_cast<uint32_t>(pool.GetCount());
+
+	uint32_t index;
+	if (freeHandles_.empty()) {
+		index = static_cast<uint32_t>(handles_.size());
+		assert(index < 0xFFFFFFFF);
+		handles_.push_back({type, slot, 0, true});
+	} else {
+		index = freeHandles_.back();
+		freeHandles_.pop_back();
+		HandleEntry& entry = handles_[index];
+		entry = {type, slot, entry.generation, true};
+	}
+
+	pool.params.insert(pool.params.end(), params, params + pool.paramCount);
+	pool.colors.push_back(color);
+	pool.lifetimes.push_back((std::max)(lifetime, 1u));
+	pool.handles.push_back(index);
+	pool.dirty.push_back(1);
+	pool.bounds.push_back({});
+	// 頂点は最初の Draw で Tessellate が作る
+	tessellatePoints_.resize(pool.pointCount);
+	pool.shapes.AddShape(tessellatePoints_.data(), pool.pointCount);
+	return (static_cast<DebugShapeHandle>(handles_[index].generation) << kHandleIndexBits) | index;
+}
+
+void DebugScene::Set(DebugShapeHandle shape, ShapeType type, const float* params) {
+	const HandleEntry* entry = Find(shape);
+	if (!entry || entry->type != type) {
+		return;
+	}
+	Pool& pool = pools_[type];
+	float* current = pool.params.data() + entry->slot * pool.paramCount;
+	if (std::memcmp(current, params, pool.paramCount * sizeof(float)) != 0) {
+		std::memcpy(current, params, pool.paramCount * sizeof(float));
+		pool.dirty[entry->slot] = 1;
+	}
+}
+
+const DebugScene::HandleEntry* DebugScene::Find(DebugShapeHandle shape) const {
+	uint32_t index = static_cast<uint32_t>(shape);
+	if (index >= handles_.size()) {
+		return nullptr;
+	}
+	const HandleEntry& entry = handles_[index];
+	if (!entry.alive || entry.generation != static_cast<uint32_t>(shape >> kHandleIndexBits)) {
+		return nullptr;
+	}
+	return &entry;
+}
+
+void DebugScene::RemoveSlot(ShapeType type, uint32_t slot) {
+	Pool& pool = pools_[type];
+	uint32_t last = static_cast<uint32_t>(pool.GetCount() - 1);
+
+	// 番号を使えなくして、世代を進めてから使い回す（世代が一周すると古い番号と見分けられないので使い回さない）
+	HandleEntry& removed = handles_[pool.handles[slot]];
+	removed.alive = false;
+	if (++removed.generation != 0) {
+		freeHandles_.push_back(pool.handles[slot]);
+	}
+
+	// 最後の図形を消した場所へ移す
+	if (slot != last) {
+		std::memcpy(pool.params.data() + slot * pool.paramCount, pool.params.data() + last * pool.paramCount, pool.paramCount * sizeof(float));
+		pool.colors[slot] = pool.colors[last];
+		pool.lifetimes[slot] = pool.lifetimes[last];
+		pool.handles[slot] = pool.handles[last];
+		pool.dirty[slot] = pool.dirty[last];
+		pool.bounds[slot] = pool.bounds[last];
+		handles_[pool.handles[slot]].slot = slot;
+	}
+	pool.shapes.RemoveShape(slot);
+	pool.params.resize(last * pool.paramCount);
+	pool.colors.pop_back();
+	pool.lifetimes.pop_back();
+	pool.handles.pop_back();
+	pool.dirty.pop_back();
+	pool.bounds.pop_back();
+}
+
+void DebugScene::Tessellate(ShapeType type, uint32_t slot) {
+	Pool& pool = pools_[type];
+	const float* p = pool.params.data() + slot * pool.paramCount;
+	tessellatePoints_.resize(pool.pointCount);
+	Vector3* points = tessellatePoints_.data();
+
+	switch (type) {
+	case kSphere: {
+		// 単位球の頂点を中心と半径で置く（囲む球は球そのもの）
+		const WireframeMesh& sphere = GetUnitSphereWireframe(kSphereSubdivision);
+		Vector3 center = LoadVector3(p);
+		float radius = p[3];
+		for (uint32_t i = 0; i < pool.pointCount; ++i) {
+			points[i] = {center.x + sphere.vertices[i].x * radius, center.y + sphere.vertices[i].y * radius, center.z + sphere.vertices[i].z * radius};
+		}
+		pool.bounds[slot] = {center, radius};
+		break;
+	}
+	case kSegment:
+		points[0] = LoadVector3(p);
+		points[1] = points[0] + LoadVector3(p + 3);
+		break;
+	case kAABB:
+		MakeBoxCorners(AABB{LoadVector3(p), LoadVector3(p + 3)}, points);
+		break;
+	case kOBB: {
+		Matrix4x4 worldMatrix;
+		std::memcpy(worldMatrix.m, p + 3, sizeof(worldMatrix.m));
+		MakeBoxCorners(LoadVector3(p), worldMatrix, points);
+		break;
+	}
+	case kPlane:
+		MakePlaneCorners(Plane{LoadVector3(p), p[3]}, points);
+		break;
+	case kTriangle:
+		for (int i = 0; i < 3; ++i) {
+			points[i] = LoadVector3(p + i * 3);
+		}
+		break;
+	case kBezier:
+		for (uint32_t i = 0; i <= kBezierDivision; ++i) {
+			float t = static_cast<float>(i) / static_cast<float>(kBezierDivision);
+			points[i] = Bezier(LoadVector3(p), LoadVector3(p + 3), LoadVector3(p + 6), t);
+		}
+		break;
+	default:
+		break;
+	}
+	if (type != kSphere) {
+		pool.bounds[slot] = MakeBoundingSphere(points, pool.pointCount);
+	}
+	pool.shapes.SetPoints(slot, points);
+	pool.dirty[slot] = 0;
+}
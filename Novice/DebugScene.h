@@ -0,0 +1,131 @@
+#pragma once
+#include "Geometry.h"
+#include "ProjectionCache.h"
+#include "ScreenProjector.h"
+#include "Wireframe.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// DebugScene に登録した図形の番号（下位32ビットが場所、上位32ビットが世代。消えた図形の番号は IsAlive が false になる）
+using DebugShapeHandle = uint64_t;
+
+// 図形がないことを表す番号
+const DebugShapeHandle kInvalidDebugShape = 0xFFFFFFFFFFFFFFFF;
+
+// 寿命を指定しない（Remove するまで残る）
+const uint32_t kDebugShapeForever = 0xFFFFFFFF;
+
+/// <summary>
+/// 図形を一度登録しておき、毎フレーム Draw でまとめて描くデバッグ表示（リテインドモード）。
+/// 図形の線は種類ごとのプールの ProjectionCache にワールド座標の頂点として続けて並べ、形が変わったときだけ作り直す。
+/// 頂点の変換もカメラの番号（CameraVersionCounter）が変わったときだけ行うので、動かない図形は毎フレームほとんど手間がかからない。
+/// 球は kSphereSubdivision、ベジエ曲線は kBezierDivision の分割数で作る
+/// </summary>
+class DebugScene {
+public:
+	DebugScene();
+
+	//=== 図形の追加（lifetime は描くフレーム数。Update を呼ぶたびに1減り、0 になると消える） ===//
+
+	DebugShapeHandle AddSphere(const Vector3& center, float radius, uint32_t color, uint32_t lifetime = kDebugShapeForever);
+	DebugShapeHandle AddSegment(const Vector3& origin, const Vector3& diff, uint32_t color, uint32_t lifetime = kDebugShapeForever);
+	DebugShapeHandle AddAABB(const AABB& aabb, uint32_t color, uint32_t lifetime = kDebugShapeForever);
+	DebugShapeHandle AddOBB(const Vector3& size, const Matrix4x4& worldMatrix, uint32_t color, uint32_t lifetime = kDebugShapeForever);
+	DebugShapeHandle AddPlane(const Plane& plane, uint32_t color, uint32_t lifetime = kDebugShapeForever);
+	DebugShapeHandle AddTriangle(const Triangle& triangle, uint32_t color, uint32_t lifetime = kDebugShapeForever);
+	DebugShapeHandle AddBezier(const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2, uint32_t color, uint32_t lifetime = kDebugShapeForever);
+
+	//=== 形を変える（値が前と同じなら何もしない。違えば次の Draw で線を作り直す）。消えた図形や種類の違う図形は無視する ===//
+
+	void SetSphere(DebugShapeHandle shape, const Vector3& center, float radius);
+	void SetSegment(DebugShapeHandle shape, const Vector3& origin, const Vector3& diff);
+	void SetAABB(DebugShapeHandle shape, const AABB& aabb);
+	void SetOBB(DebugShapeHandle shape, const Vector3& size, const Matrix4x4& worldMatrix);
+	void SetPlane(DebugShapeHandle shape, const Plane& plane);
+	void SetTriangle(DebugShapeHandle shape, const Triangle& triangle);
+	void SetBezier(DebugShapeHandle shape, const Vector3& controlPoint0, const Vector3& controlPoint1, const Vector3& controlPoint2);
+
+	// 色を変える（線は作り直さない）
+	void SetColor(DebugShapeHandle shape, uint32_t color);
+
+	// 寿命を設定し直す（kDebugShapeForever で消えなくなる）
+	void SetLifetime(DebugShapeHandle shape, uint32_t lifetime);
+
+	void Remove(DebugShapeHandle shape);
+
+	bool IsAlive(DebugShapeHandle shape) const;
+
+	// 全部の図形を消す
+	void Clear();
+
+	/// <summary>
+	/// 寿命を1フレーム分進め、尽きた図形を消す（毎フレームの初めに1回呼ぶ）
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 全部の図形を描く（SetLineBatch / SetLineDrawFunction の先へ。判定の結果は GetDebugDrawStats に足す）
+	/// </summary>
+	/// <param name="projector">スクリーン座標への変換（CameraVersionCounter で番号を付けておくと変換を使い回す）</param>
+	void Draw(const ScreenProjector& projector);
+
+	// 登録している図形の数
+	size_t GetShapeCount() const;
+
+	// 直前の Draw で線を作り直した図形の数と、変換した頂点の数
+	uint32_t GetLastTessellatedCount() const { return lastTessellatedCount_; }
+	uint32_t GetLastTransformedCount() const { return lastTransformedCount_; }
+
+private:
+	enum ShapeType : uint32_t {
+		kSphere,
+		kSegment,
+		kAABB,
+		kOBB,
+		kPlane,
+		kTriangle,
+		kBezier,
+		kShapeTypeCount,
+	};
+
+	// 種類ごとの図形。場所（slot）に詰めて並べ、消すときは最後の図形で穴を埋める
+	struct Pool {
+		uint32_t paramCount = 0;              // 1図形あたりの形の値（float）の数
+		uint32_t pointCount = 0;              // 1図形あたりの頂点の数
+		std::vector<WireframeEdge> edges;     // 1図形分の辺（頂点は図形の先頭からの番号）
+		std::vector<float> params;            // 形の値（slot × paramCount）
+		std::vector<uint32_t> colors;         // 色
+		std::vector<uint32_t> lifetimes;      // 残りのフレーム数
+		std::vector<uint32_t> handles;        // slot → handles_ の番号
+		std::vector<uint8_t> dirty;           // 線を作り直す
+		std::vector<Sphere> bounds;           // 視錐台の判定に使う、頂点を囲む球
+		ProjectionCache shapes;               // ワールド座標の頂点と変換した頂点（図形の番号は slot と同じ）
+
+		size_t GetCount() const { return colors.size(); }
+	};
+
+	// 番号から図形の場所を引く表
+	struct HandleEntry {
+		uint32_t type;
+		uint32_t slot;
+		uint32_t generation; // 番号を使い回すたびに進める（一周したらその場所は使い回さない）
+		bool alive;
+	};
+
+	DebugShapeHandle Add(ShapeType type, const float* params, uint32_t color, uint32_t lifetime);
+	void Set(DebugShapeHandle shape, ShapeType type, const float* params);
+	// 生きている図形の表の項目（なければ nullptr）
+	const HandleEntry* Find(DebugShapeHandle shape) const;
+	void RemoveSlot(ShapeType type, uint32_t slot);
+	// 形の値から頂点と囲む球を作る
+	void Tessellate(ShapeType type, uint32_t slot);
+
+	Pool pools_[kShapeTypeCount];
+	std::vector<HandleEntry> handles_;
+	std::vector<uint32_t> freeHandles_;
+	std::vector<Vector3> tessellatePoints_; // Tessellate で頂点を作る場所
+
+	uint32_t lastTessellatedCount_ = 0;
+	uint32_t lastTransformedCount_ = 0;
+};
@@ -0,0 +1,189 @@
+#include "DrawCommandStream.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// ヘッダの大きさ（マジック・バージョン・幅・高さ）
+const size_t kHeaderSize = 16;
+
+void AppendUint32(std::vector<uint8_t>& buffer, uint32_t value) {
+	for (int shift = 0; shift < 32; shift += 8) {
+		buffer.push_back(static_cast<uint8_t>(value >> shift));
+	}
+}
+
+uint32_t LoadUint32(const uint8_t* p) { return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24; }
+
+} // namespace
+
+//=== DrawCommandWriter ===//
+
+bool DrawCommandWriter::Open(const char* path) {
+	Close();
+	file_ = std::fopen(path, "wb");
+	headerWritten_ = false;
+	buffer_.clear();
+	lastX_ = lastY_ = 0;
+	hasColor_ = false;
+	writtenBytes_ = 0;
+	frameCount_ = 0;
+	return file_ != nullptr;
+}
+
+void DrawCommandWriter::Close() {
+	if (file_) {
+		std::fclose(file_);
+		file_ = nullptr;
+	}
+}
+
+void DrawCommandWriter::SetScreenSize(int width, int height) {
+	width_ = width;
+	height_ = height;
+}
+
+void DrawCommandWriter::AddLine(int x1, int y1, int x2, int y2, uint32_t color) {
+	if (hasColor_ && color == lastColor_) {
+		buffer_.push_back(kDrawCommandLine);
+	} else {
+		buffer_.push_back(kDrawCommandLineColor);
+		AppendUint32(buffer_, color);
+		lastColor_ = color;
+		hasColor_ = true;
+	}
+	// 差はオーバーフローしても、読むときに同じ順で足せば元に戻る
+	WriteVarint(static_cast<int32_t>(static_cast<uint32_t>(x1) - static_cast<uint32_t>(lastX_)));
+	WriteVarint(static_cast<int32_t>(static_cast<uint32_t>(y1) - static_cast<uint32_t>(lastY_)));
+	WriteVarint(static_cast<int32_t>(static_cast<uint32_t>(x2) - static_cast<uint32_t>(x1)));
+	WriteVarint(static_cast<int32_t>(static_cast<uint32_t>(y2) - static_cast<uint32_t>(y1)));
+	lastX_ = x2;
+	lastY_ = y2;
+}
+
+void DrawCommandWriter::AddLines(const ScreenLine* lines, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		AddLine(lines[i].x1, lines[i].y1, lines[i].x2, lines[i].y2, lines[i].color);
+	}
+}
+
+void DrawCommandWriter::EndFrame() {
+	buffer_.push_back(kDrawCommandEndFrame);
+	if (file_) {
+		if (!headerWritten_) {
+			std::vector<uint8_t> header(kDrawCommandMagic, kDrawCommandMagic + sizeof(kDrawCommandMagic));
+			AppendUint32(header, kDrawCommandVersion);
+			AppendUint32(header, static_cast<uint32_t>(width_));
+			AppendUint32(header, static_cast<uint32_t>(height_));
+			writtenBytes_ += std::fwrite(header.data(), 1, header.size(), file_);
+			headerWritten_ = true;
+		}
+		writtenBytes_ += std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+	}
+	buffer_.clear();
+	++frameCount_;
+}
+
+void DrawCommandWriter::WriteVarint(int32_t value) {
+	// 符号を最下位ビットへ回して、絶対値の小さい数を短くする
+	uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+	while (zigzag >= 0x80) {
+		buffer_.push_back(static_cast<uint8_t>(zigzag | 0x80));
+		zigzag >>= 7;
+	}
+	buffer_.push_back(static_cast<uint8_t>(zigzag));
+}
+
+//=== DrawCommandReader ===//
+
+bool DrawCommandReader::Load(const char* path) {
+	FILE* file = std::fopen(path, "rb");
+	if (!file) {
+		return false;
+	}
+	std::vector<uint8_t> data;
+	uint8_t chunk[65536];
+	size_t read;
+	while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+		data.insert(data.end(), chunk, chunk + read);
+	}
+	std::fclose(file);
+	return Load(std::move(data));
+}
+
+bool DrawCommandReader::Load(std::vector<uint8_t> data) {
+	data_ = std::move(data);
+	position_ = bodyBegin_ = 0;
+	error_ = false;
+	if (data_.size() < kHeaderSize || std::memcmp(data_.data(), kDrawCommandMagic, sizeof(kDrawCommandMagic)) != 0 || LoadUint32(data_.data() + 4) != kDrawCommandVersion) {
+		error_ = true;
+		return false;
+	}
+	width_ = static_cast<int32_t>(LoadUint32(data_.data() + 8));
+	height_ = static_cast<int32_t>(LoadUint32(data_.data() + 12));
+	bodyBegin_ = kHeaderSize;
+	Rewind();
+	return true;
+}
+
+bool DrawCommandReader::ReadFrame(std::vector<ScreenLine>& lines) {
+	lines.clear();
+	if (error_ || position_ >= data_.size()) {
+		return false;
+	}
+	while (position_ < data_.size()) {
+		uint8_t command = data_[position_++];
+		if (command == kDrawCommandEndFrame) {
+			return true;
+		}
+		if (command == kDrawCommandLineColor) {
+			if (data_.size() - position_ < 4) {
+				break;
+			}
+			lastColor_ = LoadUint32(data_.data() + position_);
+			position_ += 4;
+		} else if (command != kDrawCommandLine) {
+			break;
+		}
+		int32_t d[4];
+		if (!ReadVarint(d[0]) || !ReadVarint(d[1]) || !ReadVarint(d[2]) || !ReadVarint(d[3])) {
+			break;
+		}
+		ScreenLine line;
+		line.x1 = static_cast<int32_t>(static_cast<uint32_t>(lastX_) + static_cast<uint32_t>(d[0]));
+		line.y1 = static_cast<int32_t>(static_cast<uint32_t>(lastY_) + static_cast<uint32_t>(d[1]));
+		line.x2 = static_cast<int32_t>(static_cast<uint32_t>(line.x1) + static_cast<uint32_t>(d[2]));
+		line.y2 = static_cast<int32_t>(static_cast<uint32_t>(line.y1) + static_cast<uint32_t>(d[3]));
+		line.color = lastColor_;
+		lastX_ = line.x2;
+		lastY_ = line.y2;
+		lines.push_back(line);
+	}
+	// 区切りの前に記録が終わったか、知らないコマンドがあった
+	error_ = true;
+	lines.clear();
+	return false;
+}
+
+void DrawCommandReader::Rewind() {
+	position_ = bodyBegin_;
+	lastX_ = lastY_ = 0;
+	lastColor_ = 0;
+	error_ = bodyBegin_ == 0;
+}
+
+bool DrawCommandReader::ReadVarint(int32_t& value) {
+	uint32_t zigzag = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		if (position_ >= data_.size()) {
+			return false;
+		}
+		uint8_t byte = data_[position_++];
+		zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			value = static_cast<int32_t>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+			return true;
+		}
+	}
+	return false;
+}
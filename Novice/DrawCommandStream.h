@@ -0,0 +1,130 @@
+#pragma once
+// 1フレームずつの描画コマンド（線とフレームの区切り）を詰めたバイナリで記録・再生する。
+//
+// 記録の形式（リトルエンディアン）
+//   ヘッダ  : "NVDC"、バージョン(uint32)、画面の幅(int32)、画面の高さ(int32)
+//   コマンド: 1バイトの種類に続けて
+//     kDrawCommandLine      : 座標4つ
+//     kDrawCommandLineColor : 色(uint32)、座標4つ
+//     kDrawCommandEndFrame  : なし
+//   座標は (x1 - 前の線の x2, y1 - 前の線の y2, x2 - x1, y2 - y1) をジグザグ符号化した可変長整数（7ビットずつ、下位から）。
+//   前の線はフレームをまたいで引き継ぎ、最初は (0, 0)。色は前の線と違うときだけ書く
+#include "LineBatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+const char kDrawCommandMagic[4] = {'N', 'V', 'D', 'C'};
+const uint32_t kDrawCommandVersion = 1;
+
+// コマンドの種類
+enum : uint8_t {
+	kDrawCommandEndFrame = 0,
+	kDrawCommandLine = 1,
+	kDrawCommandLineColor = 2,
+};
+
+/// <summary>
+/// 描画コマンドを記録ファイルへ書き出す。1フレーム分をメモリにためておき、EndFrame でまとめて書く
+/// </summary>
+class DrawCommandWriter {
+public:
+	DrawCommandWriter() = default;
+	~DrawCommandWriter() { Close(); }
+	DrawCommandWriter(const DrawCommandWriter&) = delete;
+	DrawCommandWriter& operator=(const DrawCommandWriter&) = delete;
+
+	/// <summary>
+	/// 記録ファイルを開く（ヘッダは最初の EndFrame で書く）
+	/// </summary>
+	/// <param name="path">出力先</param>
+	/// <returns>開けたか</returns>
+	bool Open(const char* path);
+
+	void Close();
+
+	bool IsOpen() const { return file_ != nullptr; }
+
+	/// <summary>
+	/// ヘッダに書く画面の大きさ（最初の EndFrame より前に設定する）
+	/// </summary>
+	void SetScreenSize(int width, int height);
+
+	void AddLine(int x1, int y1, int x2, int y2, uint32_t color);
+
+	// LineBatch の Flush 先としても使えるよう、まとめて追加する
+	void AddLines(const ScreenLine* lines, size_t count);
+
+	/// <summary>
+	/// フレームの区切りを書き、ためたコマンドをファイルへ書き出す
+	/// </summary>
+	void EndFrame();
+
+	// 書き出したバイト数（ヘッダを含む）とフレーム数
+	uint64_t GetWrittenBytes() const { return writtenBytes_; }
+	uint64_t GetFrameCount() const { return frameCount_; }
+
+private:
+	void WriteVarint(int32_t value);
+
+	FILE* file_ = nullptr;
+	bool headerWritten_ = false;
+	int width_ = 0;
+	int height_ = 0;
+	std::vector<uint8_t> buffer_; // 今のフレームのコマンド
+	int32_t lastX_ = 0;
+	int32_t lastY_ = 0;
+	uint32_t lastColor_ = 0;
+	bool hasColor_ = false;
+	uint64_t writtenBytes_ = 0;
+	uint64_t frameCount_ = 0;
+};
+
+/// <summary>
+/// 記録ファイルを丸ごと読み込み、1フレームずつ線に戻す
+/// </summary>
+class DrawCommandReader {
+public:
+	/// <summary>
+	/// 記録ファイルを読み込む
+	/// </summary>
+	/// <param name="path">記録ファイル</param>
+	/// <returns>読めて、ヘッダが正しかったか</returns>
+	bool Load(const char* path);
+
+	/// <summary>
+	/// メモリ上の記録を使う（ヘッダから）
+	/// </summary>
+	bool Load(std::vector<uint8_t> data);
+
+	/// <summary>
+	/// 次のフレームの線を読む
+	/// </summary>
+	/// <param name="lines">線の書き込み先（前の中身は消す）</param>
+	/// <returns>フレームを最後まで読めたか（記録の終わりか壊れていれば false）</returns>
+	bool ReadFrame(std::vector<ScreenLine>& lines);
+
+	// 最初のフレームに戻る
+	void Rewind();
+
+	// 記録が壊れていたか（ReadFrame が途中で失敗した）
+	bool HasError() const { return error_; }
+
+	int GetWidth() const { return width_; }
+	int GetHeight() const { return height_; }
+	size_t GetSize() const { return data_.size(); }
+
+private:
+	bool ReadVarint(int32_t& value);
+
+	std::vector<uint8_t> data_;
+	size_t position_ = 0;
+	size_t bodyBegin_ = 0;
+	int width_ = 0;
+	int height_ = 0;
+	int32_t lastX_ = 0;
+	int32_t lastY_ = 0;
+	uint32_t lastColor_ = 0;
+	bool error_ = false;
+};
@@ -0,0 +1,272 @@
+#include "FastMath.h"
+#include "MathSimd.h"
+#include <atomic>
+
+namespace {
+
+// ThreadPool や RenderThread の作業スレッドからも読むので atomic にする（値だけ見ればよいので順序の保証は要らない）
+std::atomic<MathAccuracy> defaultMathAccuracy = MathAccuracy::Exact;
+
+} // namespace
+
+void SetDefaultMathAccuracy(MathAccuracy accuracy) { defaultMathAccuracy.store(accuracy, std::memory_order_relaxed); }
+
+MathAccuracy GetDefaultMathAccuracy() { return defaultMathAccuracy.load(std::memory_order_relaxed); }
+
+const char* GetMathAccuracyName(MathAccuracy accuracy) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		return "Exact";
+	case MathAccuracy::Fast:
+		return "Fast";
+	default:
+		return "Approx";
+	}
+}
+
+namespace FastMath {
+
+#if defined(MATH_SIMD_SSE)
+
+namespace {
+
+using MathSimd::LoadSoA4;
+using MathSimd::MulAdd;
+using MathSimd::StoreAoS4;
+
+// 4要素分の 1 / sqrt(x)
+template<MathAccuracy kAccuracy> inline __m128 Rsqrt4(__m128 x) {
+	if constexpr (kAccuracy == MathAccuracy::Exact) {
+		return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+	} else {
+		__m128 y = _mm_rsqrt_ps(x);
+		if constexpr (kAccuracy == MathAccuracy::Fast) {
+			// y * (1.5 - 0.5 * x * y * y)
+			__m128 halfXY = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), y);
+			y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfXY, y)));
+		}
+		return y;
+	}
+}
+
+// 4要素分の sin / cos（スカラー版 SinCos と同じ手順）
+template<MathAccuracy kAccuracy> inline void SinCos4(__m128 x, __m128& s, __m128& c) {
+	__m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(kTwoOverPi)));
+	__m128 qf = _mm_cvtepi32_ps(q);
+	__m128 r = MulAdd(qf, _mm_set1_ps(-kPiOver2Hi), x);
+	r = MulAdd(qf, _mm_set1_ps(-kPiOver2Mid), r);
+	r = MulAdd(qf, _mm_set1_ps(-kPiOver2Lo), r);
+	__m128 z = _mm_mul_ps(r, r);
+
+	__m128 sinR, cosR;
+	if constexpr (kAccuracy == MathAccuracy::Fast) {
+		__m128 ps = MulAdd(_mm_set1_ps(-1.9515295891e-4f), z, _mm_set1_ps(8.3321608736e-3f));
+		ps = MulAdd(ps, z, _mm_set1_ps(-1.6666654611e-1f));
+		sinR = MulAdd(_mm_mul_ps(ps, z), r, r);
+		__m128 pc = MulAdd(_mm_set1_ps(2.443315711809948e-5f), z, _mm_set1_ps(-1.388731625493765e-3f));
+		pc = MulAdd(pc, z, _mm_set1_ps(4.166664568298827e-2f));
+		cosR = MulAdd(_mm_mul_ps(pc, z), z, MulAdd(_mm_set1_ps(-0.5f), z, _mm_set1_ps(1.0f)));
+	} else {
+		__m128 ps = MulAdd(_mm_set1_ps(8.3333333e-3f), z, _mm_set1_ps(-1.6666667e-1f));
+		sinR = MulAdd(_mm_mul_ps(ps, z), r, r);
+		__m128 pc = MulAdd(_mm_set1_ps(4.1666667e-2f), z, _mm_set1_ps(-0.5f));
+		cosR = MulAdd(pc, z, _mm_set1_ps(1.0f));
+	}
+
+	// 奇数象限は sin と cos を入れ替える
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i two = _mm_set1_epi32(2);
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+	__m128 sinV = _mm_or_ps(_mm_and_ps(swap, cosR), _mm_andnot_ps(swap, sinR));
+	__m128 cosV = _mm_or_ps(_mm_and_ps(swap, sinR), _mm_andnot_ps(swap, cosR));
+
+	// 符号は sin が q の第1ビット、cos が (q + 1) の第1ビットで決まる
+	__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30));
+	__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30));
+	s = _mm_xor_ps(sinV, sinSign);
+	c = _mm_xor_ps(cosV, cosSign);
+}
+
+template<MathAccuracy kAccuracy> void RsqrtArrayImpl(const float* in, size_t count, float* out) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(out + i, Rsqrt4<kAccuracy>(_mm_loadu_ps(in + i)));
+	}
+	for (; i < count; ++i) {
+		out[i] = Rsqrt<kAccuracy>(in[i]);
+	}
+}
+
+template<MathAccuracy kAccuracy> void SinCosArrayImpl(const float* in, size_t count, float* sinOut, float* cosOut) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 s, c;
+		SinCos4<kAccuracy>(_mm_loadu_ps(in + i), s, c);
+		_mm_storeu_ps(sinOut + i, s);
+		_mm_storeu_ps(cosOut + i, c);
+	}
+	for (; i < count; ++i) {
+		SinCos<kAccuracy>(in[i], sinOut[i], cosOut[i]);
+	}
+}
+
+template<MathAccuracy kAccuracy> void LengthArrayImpl(const Vector3* in, size_t count, float* out) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		LoadSoA4(in + i, x, y, z);
+		__m128 lengthSq = MulAdd(z, z, MulAdd(y, y, _mm_mul_ps(x, x)));
+		__m128 length;
+		if constexpr (kAccuracy != MathAccuracy::Approx) {
+			length = _mm_sqrt_ps(lengthSq);
+		} else {
+			// 長さ0の要素は rsqrt が無限大になるのでマスクで0に戻す
+			__m128 nonZero = _mm_cmpgt_ps(lengthSq, _mm_setzero_ps());
+			length = _mm_and_ps(nonZero, _mm_mul_ps(lengthSq, Rsqrt4<kAccuracy>(lengthSq)));
+		}
+		_mm_storeu_ps(out + i, length);
+	}
+	for (; i < count; ++i) {
+		out[i] = FastLength<kAccuracy>(in[i]);
+	}
+}
+
+template<MathAccuracy kAccuracy> void NormalizeArrayImpl(const Vector3* in, size_t count, Vector3* out) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		LoadSoA4(in + i, x, y, z);
+		__m128 lengthSq = MulAdd(z, z, MulAdd(y, y, _mm_mul_ps(x, x)));
+		__m128 inverseLength = Rsqrt4<kAccuracy>(lengthSq);
+		if constexpr (kAccuracy != MathAccuracy::Exact) {
+			// 長さ0の要素はスカラー版と同様にそのまま返す
+			__m128 nonZero = _mm_cmpgt_ps(lengthSq, _mm_setzero_ps());
+			inverseLength = _mm_or_ps(_mm_and_ps(nonZero, inverseLength), _mm_andnot_ps(nonZero, _mm_set1_ps(1.0f)));
+		}
+		StoreAoS4(out + i, _mm_mul_ps(x, inverseLength), _mm_mul_ps(y, inverseLength), _mm_mul_ps(z, inverseLength));
+	}
+	for (; i < count; ++i) {
+		out[i] = FastNormalize<kAccuracy>(in[i]);
+	}
+}
+
+} // namespace
+
+#else
+
+namespace {
+
+template<MathAccuracy kAccuracy> void RsqrtArrayImpl(const float* in, size_t count, float* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = Rsqrt<kAccuracy>(in[i]);
+	}
+}
+
+template<MathAccuracy kAccuracy> void SinCosArrayImpl(const float* in, size_t count, float* sinOut, float* cosOut) {
+	for (size_t i = 0; i < count; ++i) {
+		SinCos<kAccuracy>(in[i], sinOut[i], cosOut[i]);
+	}
+}
+
+template<MathAccuracy kAccuracy> void LengthArrayImpl(const Vector3* in, size_t count, float* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = FastLength<kAccuracy>(in[i]);
+	}
+}
+
+template<MathAccuracy kAccuracy> void NormalizeArrayImpl(const Vector3* in, size_t count, Vector3* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = FastNormalize<kAccuracy>(in[i]);
+	}
+}
+
+} // namespace
+
+#endif
+
+void RsqrtArray(const float* in, size_t count, float* out, MathAccuracy accuracy) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		RsqrtArrayImpl<MathAccuracy::Exact>(in, count, out);
+		break;
+	case MathAccuracy::Fast:
+		RsqrtArrayImpl<MathAccuracy::Fast>(in, count, out);
+		break;
+	default:
+		RsqrtArrayImpl<MathAccuracy::Approx>(in, count, out);
+		break;
+	}
+}
+
+void SinCosArray(const float* in, size_t count, float* sinOut, float* cosOut, MathAccuracy accuracy) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		// 標準ライブラリと結果を揃えるため、Exact はスカラーで計算する
+		for (size_t i = 0; i < count; ++i) {
+			SinCos<MathAccuracy::Exact>(in[i], sinOut[i], cosOut[i]);
+		}
+		break;
+	case MathAccuracy::Fast:
+		SinCosArrayImpl<MathAccuracy::Fast>(in, count, sinOut, cosOut);
+		break;
+	default:
+		SinCosArrayImpl<MathAccuracy::Approx>(in, count, sinOut, cosOut);
+		break;
+	}
+}
+
+void LengthArray(const Vector3* in, size_t count, float* out, MathAccuracy accuracy) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		LengthArrayImpl<MathAccuracy::Exact>(in, count, out);
+		break;
+	case MathAccuracy::Fast:
+		LengthArrayImpl<MathAccuracy::Fast>(in, count, out);
+		break;
+	default:
+		LengthArrayImpl<MathAccuracy::Approx>(in, count, out);
+		break;
+	}
+}
+
+void NormalizeArray(const Vector3* in, size_t count, Vector3* out, MathAccuracy accuracy) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		NormalizeArrayImpl<MathAccuracy::Exact>(in, count, out);
+		break;
+	case MathAccuracy::Fast:
+		NormalizeArrayImpl<MathAccuracy::Fast>(in, count, out);
+		break;
+	default:
+		NormalizeArrayImpl<MathAccuracy::Approx>(in, count, out);
+		break;
+	}
+}
+
+} // namespace FastMath
+
+void MathDetail::SinCos3(const Vector3& rotate, Vector3& s, Vector3& c) {
+	MathAccuracy accuracy = GetDefaultMathAccuracy();
+#if defined(MATH_SIMD_SSE)
+	// Fast / Approx は3軸を1回の SinCos4 で求める（1つずつだと標準ライブラリより遅い）
+	if (accuracy != MathAccuracy::Exact) {
+		__m128 angles = _mm_set_ps(0.0f, rotate.z, rotate.y, rotate.x);
+		__m128 sin4, cos4;
+		if (accuracy == MathAccuracy::Fast) {
+			FastMath::SinCos4<MathAccuracy::Fast>(angles, sin4, cos4);
+		} else {
+			FastMath::SinCos4<MathAccuracy::Approx>(angles, sin4, cos4);
+		}
+		alignas(16) float sinOut[4];
+		alignas(16) float cosOut[4];
+		_mm_store_ps(sinOut, sin4);
+		_mm_store_ps(cosOut, cos4);
+		s = {sinOut[0], sinOut[1], sinOut[2]};
+		c = {cosOut[0], cosOut[1], cosOut[2]};
+		return;
+	}
+#endif
+	FastMath::SinCos(rotate.x, s.x, c.x, accuracy);
+	FastMath::SinCos(rotate.y, s.y, c.y, accuracy);
+	FastMath::SinCos(rotate.z, s.z, c.z, accuracy);
+}
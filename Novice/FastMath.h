@@ -0,0 +1,263 @@
+#pragma once
+#include "MathFunction.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(MATH_SIMD_SSE)
+#include <immintrin.h>
+#endif
+
+/// <summary>
+/// 近似計算の精度段階
+/// Exact  : 標準ライブラリと同じ結果（既定）
+/// Fast   : 誤差数ULP程度の近似（描画・物理の大半はこれで足りる）
+/// Approx : 相対誤差 1e-3 前後まで許す最速の近似
+/// </summary>
+enum class MathAccuracy { Exact, Fast, Approx };
+
+/// <summary>
+/// 精度段階を指定しない呼び出しで使う既定の精度段階を設定する（起動時に1回設定する想定。
+/// どのスレッドから読み書きしてもよいが、計算中のほかのスレッドへいつ届くかは決まらない）
+/// </summary>
+/// <param name="accuracy">精度段階</param>
+void SetDefaultMathAccuracy(MathAccuracy accuracy);
+
+/// <summary>
+/// 既定の精度段階を取得する
+/// </summary>
+/// <returns>精度段階</returns>
+MathAccuracy GetDefaultMathAccuracy();
+
+/// <summary>
+/// 精度段階の名前（ベンチマークやデバッグ表示用）
+/// </summary>
+/// <param name="accuracy">精度段階</param>
+/// <returns>"Exact" / "Fast" / "Approx"</returns>
+const char* GetMathAccuracyName(MathAccuracy accuracy);
+
+namespace FastMath {
+
+// sin / cos の範囲縮約に使う定数（π/2 を3つに分けて引き、桁落ちを抑える）
+constexpr float kTwoOverPi = 0.636619772367581343f;
+constexpr float kPiOver2Hi = 1.5703125f;
+constexpr float kPiOver2Mid = 4.837512969970703125e-4f;
+constexpr float kPiOver2Lo = 7.54978995489188216e-8f;
+
+/// <summary>
+/// 1 / sqrt(x)
+/// </summary>
+/// <param name="x">正の値</param>
+/// <returns>逆数平方根</returns>
+template<MathAccuracy kAccuracy = MathAccuracy::Fast> inline float Rsqrt(float x) {
+	if constexpr (kAccuracy == MathAccuracy::Exact) {
+		return 1.0f / std::sqrt(x);
+	} else {
+#if defined(MATH_SIMD_SSE)
+		// rsqrtss は約12ビット精度
+		float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+		if constexpr (kAccuracy == MathAccuracy::Fast) {
+			// ニュートン法1回で約22ビットまで上げる
+			y = y * (1.5f - 0.5f * x * y * y);
+		}
+		return y;
+#else
+		if constexpr (kAccuracy == MathAccuracy::Fast) {
+			// SIMDが無い場合、ビット演算＋ニュートン法で数ULPまで詰めるより平方根命令の方が速い
+			return 1.0f / std::sqrt(x);
+		} else {
+			// ビット演算による初期値＋ニュートン法1回
+			uint32_t bits;
+			std::memcpy(&bits, &x, sizeof(bits));
+			bits = 0x5F375A86u - (bits >> 1);
+			float y;
+			std::memcpy(&y, &bits, sizeof(y));
+			return y * (1.5f - 0.5f * x * y * y);
+		}
+#endif
+	}
+}
+
+/// <summary>
+/// sin と cos を同時に求める（Fast / Approx は |x| が数千ラジアン以内を想定）。
+/// 1つずつ求めるときは Fast より標準ライブラリ（Exact）の方が速いので、既定は Exact にしている。
+/// Fast が速いのは SinCosArray などで4つ同時に求めるとき
+/// </summary>
+/// <param name="x">角度（ラジアン）</param>
+/// <param name="s">sin(x)</param>
+/// <param name="c">cos(x)</param>
+template<MathAccuracy kAccuracy = MathAccuracy::Exact> inline void SinCos(float x, float& s, float& c) {
+	if constexpr (kAccuracy == MathAccuracy::Exact) {
+		s = std::sin(x);
+		c = std::cos(x);
+	} else {
+		// x = q * (π/2) + r、|r| は π/4 以下
+#if defined(MATH_SIMD_SSE)
+		int q = _mm_cvtss_si32(_mm_set_ss(x * kTwoOverPi));
+#else
+		int q = static_cast<int>(std::lrint(x * kTwoOverPi));
+#endif
+		float qf = static_cast<float>(q);
+		float r = ((x - qf * kPiOver2Hi) - qf * kPiOver2Mid) - qf * kPiOver2Lo;
+		float z = r * r;
+
+		float sinR, cosR;
+		if constexpr (kAccuracy == MathAccuracy::Fast) {
+			// [-π/4, π/4] での最小誤差多項式
+			sinR = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+			cosR = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+		} else {
+			// テイラー展開の低次項のみ
+			sinR = (8.3333333e-3f * z - 1.6666667e-1f) * z * r + r;
+			cosR = (4.1666667e-2f * z - 0.5f) * z + 1.0f;
+		}
+
+		// 象限に応じて入れ替えと符号反転を行う（分岐予測が外れないよう選択で書く）
+		float sinV = (q & 1) ? cosR : sinR;
+		float cosV = (q & 1) ? sinR : cosR;
+		s = (q & 2) ? -sinV : sinV;
+		c = ((q + 1) & 2) ? -cosV : cosV;
+	}
+}
+
+/// <summary>
+/// ベクトルの長さ
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <returns>長さ</returns>
+template<MathAccuracy kAccuracy = MathAccuracy::Fast> inline float FastLength(const Vector3& v) {
+	float lengthSq = v.x * v.x + v.y * v.y + v.z * v.z;
+	if constexpr (kAccuracy != MathAccuracy::Approx) {
+		// 平方根命令は逆数平方根＋ニュートン法と同程度に速いので、Fast も正確な値を返す
+		return std::sqrt(lengthSq);
+	} else {
+		// sqrt(x) = x / sqrt(x)、長さ0のときは0を返す
+		return lengthSq > 0.0f ? lengthSq * Rsqrt<kAccuracy>(lengthSq) : 0.0f;
+	}
+}
+
+/// <summary>
+/// 正規化（長さ0のベクトルは Exact 以外ではそのまま返す）
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <returns>単位ベクトル</returns>
+template<MathAccuracy kAccuracy = MathAccuracy::Fast> inline Vector3 FastNormalize(const Vector3& v) {
+	float lengthSq = v.x * v.x + v.y * v.y + v.z * v.z;
+	if constexpr (kAccuracy == MathAccuracy::Exact) {
+		float inverseLength = 1.0f / std::sqrt(lengthSq);
+		return {v.x * inverseLength, v.y * inverseLength, v.z * inverseLength};
+	} else {
+		if (lengthSq <= 0.0f) {
+			return v;
+		}
+		float inverseLength = Rsqrt<kAccuracy>(lengthSq);
+		return {v.x * inverseLength, v.y * inverseLength, v.z * inverseLength};
+	}
+}
+
+//=== 実行時に精度段階を選ぶ版 ===//
+
+/// <summary>
+/// 1 / sqrt(x)（精度段階を実行時に指定）
+/// </summary>
+inline float Rsqrt(float x, MathAccuracy accuracy) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		return Rsqrt<MathAccuracy::Exact>(x);
+	case MathAccuracy::Fast:
+		return Rsqrt<MathAccuracy::Fast>(x);
+	default:
+		return Rsqrt<MathAccuracy::Approx>(x);
+	}
+}
+
+/// <summary>
+/// sin と cos を同時に求める（精度段階を実行時に指定）
+/// </summary>
+inline void SinCos(float x, float& s, float& c, MathAccuracy accuracy) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		SinCos<MathAccuracy::Exact>(x, s, c);
+		break;
+	case MathAccuracy::Fast:
+		SinCos<MathAccuracy::Fast>(x, s, c);
+		break;
+	default:
+		SinCos<MathAccuracy::Approx>(x, s, c);
+		break;
+	}
+}
+
+/// <summary>
+/// sin と cos を同時に求める（既定の精度段階）
+/// </summary>
+inline void SinCos(float x, float& s, float& c) { SinCos(x, s, c, GetDefaultMathAccuracy()); }
+
+/// <summary>
+/// ベクトルの長さ（既定の精度段階）
+/// </summary>
+inline float FastLength(const Vector3& v, MathAccuracy accuracy = GetDefaultMathAccuracy()) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		return FastLength<MathAccuracy::Exact>(v);
+	case MathAccuracy::Fast:
+		return FastLength<MathAccuracy::Fast>(v);
+	default:
+		return FastLength<MathAccuracy::Approx>(v);
+	}
+}
+
+/// <summary>
+/// 正規化（既定の精度段階）
+/// </summary>
+inline Vector3 FastNormalize(const Vector3& v, MathAccuracy accuracy = GetDefaultMathAccuracy()) {
+	switch (accuracy) {
+	case MathAccuracy::Exact:
+		return FastNormalize<MathAccuracy::Exact>(v);
+	case MathAccuracy::Fast:
+		return FastNormalize<MathAccuracy::Fast>(v);
+	default:
+		return FastNormalize<MathAccuracy::Approx>(v);
+	}
+}
+
+//=== 配列をまとめて処理する版（SIMDで4要素ずつ処理） ===//
+
+/// <summary>
+/// 配列の各要素の 1 / sqrt(x)（in と out は同じ配列でもよい）
+/// </summary>
+/// <param name="in">入力</param>
+/// <param name="count">要素数</param>
+/// <param name="out">出力</param>
+/// <param name="accuracy">精度段階</param>
+void RsqrtArray(const float* in, size_t count, float* out, MathAccuracy accuracy);
+
+/// <summary>
+/// 配列の各要素の sin と cos
+/// </summary>
+/// <param name="in">角度（ラジアン）</param>
+/// <param name="count">要素数</param>
+/// <param name="sinOut">sin の出力</param>
+/// <param name="cosOut">cos の出力</param>
+/// <param name="accuracy">精度段階</param>
+void SinCosArray(const float* in, size_t count, float* sinOut, float* cosOut, MathAccuracy accuracy);
+
+/// <summary>
+/// 配列の各ベクトルの長さ
+/// </summary>
+/// <param name="in">ベクトル</param>
+/// <param name="count">要素数</param>
+/// <param name="out">長さ</param>
+/// <param name="accuracy">精度段階</param>
+void LengthArray(const Vector3* in, size_t count, float* out, MathAccuracy accuracy);
+
+/// <summary>
+/// 配列の各ベクトルを正規化（in と out は同じ配列でもよい）
+/// </summary>
+/// <param name="in">ベクトル</param>
+/// <param name="count">要素数</param>
+/// <param name="out">単位ベクトル</param>
+/// <param name="accuracy">精度段階</param>
+void NormalizeArray(const Vector3* in, size_t count, Vector3* out, MathAccuracy accuracy);
+
+} // namespace FastMath
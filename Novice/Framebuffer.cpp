@@ -0,0 +1,39 @@
+#include "Framebuffer.h"
+#include <algorithm>
+#include <cstdio>
+
+void Framebuffer::Resize(int width, int height) {
+	width_ = (std::max)(width, 0);
+	height_ = (std::max)(height, 0);
+	pixels_.assign(static_cast<size_t>(width_) * height_, 0);
+}
+
+void Framebuffer::Clear(uint32_t color) { std::fill(pixels_.begin(), pixels_.end(), color); }
+
+bool Framebuffer::WritePpm(const char* path) const {
+	FILE* file = std::fopen(path, "wb");
+	if (!file) {
+		return false;
+	}
+	std::fprintf(file, "P6\n%d %d\n255\n", width_, height_);
+	std::vector<unsigned char> row(static_cast<size_t>(width_) * 3);
+	bool ok = true;
+	for (int y = 0; y < height_ && ok; ++y) {
+		for (int x = 0; x < width_; ++x) {
+			uint32_t pixel = GetPixel(x, y);
+			row[x * 3 + 0] = static_cast<unsigned char>(pixel >> 24);
+			row[x * 3 + 1] = static_cast<unsigned char>(pixel >> 16);
+			row[x * 3 + 2] = static_cast<unsigned char>(pixel >> 8);
+		}
+		ok = std::fwrite(row.data(), 1, row.size(), file) == row.size();
+	}
+	return std::fclose(file) == 0 && ok;
+}
+
+void DepthBuffer::Resize(int width, int height) {
+	width_ = (std::max)(width, 0);
+	height_ = (std::max)(height, 0);
+	depths_.assign(static_cast<size_t>(width_) * height_, 1.0f);
+}
+
+void DepthBuffer::Clear(float depth) { std::fill(depths_.begin(), depths_.end(), depth); }
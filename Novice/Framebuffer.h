@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// CPU で描くための RGBA の画面。1画素は Novice の色と同じ 0xRRGGBBAA の uint32_t
+/// </summary>
+class Framebuffer {
+public:
+	Framebuffer() = default;
+	Framebuffer(int width, int height) { Resize(width, height); }
+
+	/// <summary>
+	/// 大きさを変える（中身は0になる）
+	/// </summary>
+	void Resize(int width, int height);
+
+	/// <summary>
+	/// 全画素を塗りつぶす
+	/// </summary>
+	/// <param name="color">色（RGBA）</param>
+	void Clear(uint32_t color);
+
+	/// <summary>
+	/// PPM（P6、アルファは捨てる）で書き出す。ゴールデンイメージとの比較用
+	/// </summary>
+	/// <param name="path">出力先</param>
+	/// <returns>書き出せたか</returns>
+	bool WritePpm(const char* path) const;
+
+	int GetWidth() const { return width_; }
+	int GetHeight() const { return height_; }
+	uint32_t* GetPixels() { return pixels_.data(); }
+	const uint32_t* GetPixels() const { return pixels_.data(); }
+	uint32_t GetPixel(int x, int y) const { return pixels_[static_cast<size_t>(y) * width_ + x]; }
+
+private:
+	std::vector<uint32_t> pixels_;
+	int width_ = 0;
+	int height_ = 0;
+};
+
+/// <summary>
+/// Framebuffer と組で使う32ビット浮動小数点の深度バッファ（値が小さいほど手前）
+/// </summary>
+class DepthBuffer {
+public:
+	DepthBuffer() = default;
+	DepthBuffer(int width, int height) { Resize(width, height); }
+
+	/// <summary>
+	/// 大きさを変える（中身は1.0になる）
+	/// </summary>
+	void Resize(int width, int height);
+
+	/// <summary>
+	/// 全画素を同じ深度にする（毎フレームの初めに1.0で消す）
+	/// </summary>
+	void Clear(float depth = 1.0f);
+
+	int GetWidth() const { return width_; }
+	int GetHeight() const { return height_; }
+	float* GetDepths() { return depths_.data(); }
+	const float* GetDepths() const { return depths_.data(); }
+	float GetDepth(int x, int y) const { return depths_[static_cast<size_t>(y) * width_ + x]; }
+
+private:
+	std::vector<float> depths_;
+	int width_ = 0;
+	int height_ = 0;
+};
@@ -0,0 +1,229 @@
+#include "Frustum.h"
+#include "MathSimd.h"
+
+Frustum MakeFrustum(const Matrix4x4& viewProjectionMatrix) {
+	// 行ベクトルなので、クリップ座標の各成分は列との内積になる。
+	// -w <= x <= w, -w <= y <= w, 0 <= z <= w のそれぞれが平面1枚（a x + b y + c z + d >= 0）
+	const Matrix4x4& m = viewProjectionMatrix;
+	auto column = [&m](int j) { return Vector3{m.m[0][j], m.m[1][j], m.m[2][j]}; };
+	const Vector3 x = column(0);
+	const Vector3 y = column(1);
+	const Vector3 z = column(2);
+	const Vector3 w = column(3);
+	const float dx = m.m[3][0];
+	const float dy = m.m[3][1];
+	const float dz = m.m[3][2];
+	const float dw = m.m[3][3];
+
+	auto makePlane = [](const Vector3& normal, float d) {
+		float inverseLength = 1.0f / Length(normal);
+		return Plane{Multiply(inverseLength, normal), -d * inverseLength};
+	};
+
+	Frustum frustum;
+	frustum.planes[Frustum::kLeft] = makePlane(Add(w, x), dw + dx);
+	frustum.planes[Frustum::kRight] = makePlane(Subtract(w, x), dw - dx);
+	frustum.planes[Frustum::kBottom] = makePlane(Add(w, y), dw + dy);
+	frustum.planes[Frustum::kTop] = makePlane(Subtract(w, y), dw - dy);
+	frustum.planes[Frustum::kNear] = makePlane(z, dz);
+	frustum.planes[Frustum::kFar] = makePlane(Subtract(w, z), dw - dz);
+	return frustum;
+}
+
+bool IsVisible(const Frustum& frustum, const Vector3* points, size_t count) {
+	for (const Plane& plane : frustum.planes) {
+		bool allOutside = true;
+		for (size_t i = 0; i < count; ++i) {
+			if (Dot(plane.normal, points[i]) >= plane.distance) {
+				allOutside = false;
+				break;
+			}
+		}
+		if (allOutside) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#if defined(MATH_SIMD_SSE)
+
+using MathSimd::MulAdd;
+
+namespace {
+
+// 平面の成分を4レーンに広げたもの（法線の絶対値は箱の判定用）
+struct PlaneBatch {
+	__m128 nx, ny, nz, distance;
+	__m128 absNx, absNy, absNz;
+};
+
+void MakePlaneBatches(const Frustum& frustum, PlaneBatch (&batches)[Frustum::kPlaneCount]) {
+	for (int i = 0; i < Frustum::kPlaneCount; ++i) {
+		const Plane& plane = frustum.planes[i];
+		batches[i] = {
+		    _mm_set1_ps(plane.normal.x),
+		    _mm_set1_ps(plane.normal.y),
+		    _mm_set1_ps(plane.normal.z),
+		    _mm_set1_ps(plane.distance),
+		    _mm_set1_ps(std::fabs(plane.normal.x)),
+		    _mm_set1_ps(std::fabs(plane.normal.y)),
+		    _mm_set1_ps(std::fabs(plane.normal.z)),
+		};
+	}
+}
+
+// 中心から平面までの符号付き距離
+inline __m128 SignedDistance(const PlaneBatch& plane, __m128 cx, __m128 cy, __m128 cz) {
+	return _mm_sub_ps(MulAdd(cx, plane.nx, MulAdd(cy, plane.ny, _mm_mul_ps(cz, plane.nz))), plane.distance);
+}
+
+// 見えるレーンを書き込み、見えた数を返す
+inline size_t StoreVisible(__m128 outside, bool* visible) {
+	int mask = ~_mm_movemask_ps(outside) & 0xF;
+	size_t visibleCount = 0;
+	for (int lane = 0; lane < 4; ++lane) {
+		visible[lane] = (mask >> lane) & 1;
+		visibleCount += static_cast<size_t>((mask >> lane) & 1);
+	}
+	return visibleCount;
+}
+
+inline __m128 Abs(__m128 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+
+} // namespace
+
+size_t CullSpheres(const Frustum& frustum, const Sphere* spheres, size_t count, bool* visible) {
+	static_assert(sizeof(Sphere) == 16, "Sphere は4個で4x4の転置をする");
+	PlaneBatch planes[Frustum::kPlaneCount];
+	MakePlaneBatches(frustum, planes);
+
+	size_t visibleCount = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		// (center.x, center.y, center.z, radius) × 4 を成分ごとに並べ替える
+		__m128 cx = _mm_loadu_ps(&spheres[i + 0].center.x);
+		__m128 cy = _mm_loadu_ps(&spheres[i + 1].center.x);
+		__m128 cz = _mm_loadu_ps(&spheres[i + 2].center.x);
+		__m128 radius = _mm_loadu_ps(&spheres[i + 3].center.x);
+		_MM_TRANSPOSE4_PS(cx, cy, cz, radius);
+		const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+		__m128 outside = _mm_setzero_ps();
+		for (const PlaneBatch& plane : planes) {
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(SignedDistance(plane, cx, cy, cz), negativeRadius));
+		}
+		visibleCount += StoreVisible(outside, visible + i);
+	}
+	for (; i < count; ++i) {
+		visible[i] = IsVisible(frustum, spheres[i]);
+		visibleCount += visible[i] ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+size_t CullAABBs(const Frustum& frustum, const AABB* aabbs, size_t count, bool* visible) {
+	PlaneBatch planes[Frustum::kPlaneCount];
+	MakePlaneBatches(frustum, planes);
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	size_t visibleCount = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const AABB* a = aabbs + i;
+		__m128 minX = _mm_setr_ps(a[0].min.x, a[1].min.x, a[2].min.x, a[3].min.x);
+		__m128 minY = _mm_setr_ps(a[0].min.y, a[1].min.y, a[2].min.y, a[3].min.y);
+		__m128 minZ = _mm_setr_ps(a[0].min.z, a[1].min.z, a[2].min.z, a[3].min.z);
+		__m128 maxX = _mm_setr_ps(a[0].max.x, a[1].max.x, a[2].max.x, a[3].max.x);
+		__m128 maxY = _mm_setr_ps(a[0].max.y, a[1].max.y, a[2].max.y, a[3].max.y);
+		__m128 maxZ = _mm_setr_ps(a[0].max.z, a[1].max.z, a[2].max.z, a[3].max.z);
+		__m128 cx = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+		__m128 cy = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+		__m128 cz = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+		__m128 ex = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+		__m128 ey = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+		__m128 ez = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+		__m128 outside = _mm_setzero_ps();
+		for (const PlaneBatch& plane : planes) {
+			__m128 radius = MulAdd(ex, plane.absNx, MulAdd(ey, plane.absNy, _mm_mul_ps(ez, plane.absNz)));
+			__m128 distance = SignedDistance(plane, cx, cy, cz);
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+		visibleCount += StoreVisible(outside, visible + i);
+	}
+	for (; i < count; ++i) {
+		visible[i] = IsVisible(frustum, aabbs[i]);
+		visibleCount += visible[i] ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+size_t CullOBBs(const Frustum& frustum, const OBB* obbs, size_t count, bool* visible) {
+	PlaneBatch planes[Frustum::kPlaneCount];
+	MakePlaneBatches(frustum, planes);
+
+	size_t visibleCount = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const OBB* o = obbs + i;
+		__m128 cx = _mm_setr_ps(o[0].center.x, o[1].center.x, o[2].center.x, o[3].center.x);
+		__m128 cy = _mm_setr_ps(o[0].center.y, o[1].center.y, o[2].center.y, o[3].center.y);
+		__m128 cz = _mm_setr_ps(o[0].center.z, o[1].center.z, o[2].center.z, o[3].center.z);
+		// 各軸に半分の長さを掛けておく
+		__m128 axes[3][3];
+		for (int axis = 0; axis < 3; ++axis) {
+			__m128 size = _mm_setr_ps((&o[0].size.x)[axis], (&o[1].size.x)[axis], (&o[2].size.x)[axis], (&o[3].size.x)[axis]);
+			axes[axis][0] = _mm_mul_ps(size, _mm_setr_ps(o[0].orientations[axis].x, o[1].orientations[axis].x, o[2].orientations[axis].x, o[3].orientations[axis].x));
+			axes[axis][1] = _mm_mul_ps(size, _mm_setr_ps(o[0].orientations[axis].y, o[1].orientations[axis].y, o[2].orientations[axis].y, o[3].orientations[axis].y));
+			axes[axis][2] = _mm_mul_ps(size, _mm_setr_ps(o[0].orientations[axis].z, o[1].orientations[axis].z, o[2].orientations[axis].z, o[3].orientations[axis].z));
+		}
+
+		__m128 outside = _mm_setzero_ps();
+		for (const PlaneBatch& plane : planes) {
+			__m128 radius = _mm_setzero_ps();
+			for (int axis = 0; axis < 3; ++axis) {
+				radius = _mm_add_ps(radius, Abs(MulAdd(axes[axis][0], plane.nx, MulAdd(axes[axis][1], plane.ny, _mm_mul_ps(axes[axis][2], plane.nz)))));
+			}
+			__m128 distance = SignedDistance(plane, cx, cy, cz);
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+		visibleCount += StoreVisible(outside, visible + i);
+	}
+	for (; i < count; ++i) {
+		visible[i] = IsVisible(frustum, obbs[i]);
+		visibleCount += visible[i] ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+#else
+
+size_t CullSpheres(const Frustum& frustum, const Sphere* spheres, size_t count, bool* visible) {
+	size_t visibleCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		visible[i] = IsVisible(frustum, spheres[i]);
+		visibleCount += visible[i] ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+size_t CullAABBs(const Frustum& frustum, const AABB* aabbs, size_t count, bool* visible) {
+	size_t visibleCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		visible[i] = IsVisible(frustum, aabbs[i]);
+		visibleCount += visible[i] ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+size_t CullOBBs(const Frustum& frustum, const OBB* obbs, size_t count, bool* visible) {
+	size_t visibleCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		visible[i] = IsVisible(frustum, obbs[i]);
+		visibleCount += visible[i] ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+#endif
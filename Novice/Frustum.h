@@ -0,0 +1,96 @@
+#pragma once
+#include "Geometry.h"
+#include <cmath>
+#include <cstddef>
+
+/// <summary>
+/// 視錐台。6枚の平面はどれも法線が内側を向き、Dot(normal, p) >= distance なら p はその平面の内側
+/// </summary>
+struct Frustum {
+	enum { kLeft, kRight, kBottom, kTop, kNear, kFar, kPlaneCount };
+	Plane planes[kPlaneCount];
+};
+
+/// <summary>
+/// ビュー × 射影行列から視錐台を取り出す（クリップ空間の z は 0〜1）
+/// </summary>
+/// <param name="viewProjectionMatrix">ビュー × 射影行列</param>
+/// <returns>ワールド空間の視錐台</returns>
+Frustum MakeFrustum(const Matrix4x4& viewProjectionMatrix);
+
+/// <summary>
+/// 球が視錐台と重なるか（保守的な判定で、角の近くでは見えない球も重なると判定することがある）
+/// </summary>
+inline bool IsVisible(const Frustum& frustum, const Sphere& sphere) {
+	for (const Plane& plane : frustum.planes) {
+		if (Dot(plane.normal, sphere.center) - plane.distance < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// 中心と各軸方向の半分の長さ（軸は正規化していなくてもよい）で表した箱が視錐台と重なるか
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="center">中心</param>
+/// <param name="axes">各軸方向の半分の長さを掛けた軸</param>
+inline bool IsVisible(const Frustum& frustum, const Vector3& center, const Vector3 (&axes)[3]) {
+	for (const Plane& plane : frustum.planes) {
+		// 箱を平面の法線に投影したときの半径
+		float radius = std::fabs(Dot(plane.normal, axes[0])) + std::fabs(Dot(plane.normal, axes[1])) + std::fabs(Dot(plane.normal, axes[2]));
+		if (Dot(plane.normal, center) - plane.distance < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+inline bool IsVisible(const Frustum& frustum, const AABB& aabb) {
+	const Vector3 center = {(aabb.min.x + aabb.max.x) * 0.5f, (aabb.min.y + aabb.max.y) * 0.5f, (aabb.min.z + aabb.max.z) * 0.5f};
+	const Vector3 axes[3] = {
+	    {(aabb.max.x - aabb.min.x) * 0.5f, 0.0f,                             0.0f                            },
+	    {0.0f,                             (aabb.max.y - aabb.min.y) * 0.5f, 0.0f                            },
+	    {0.0f,                             0.0f,                             (aabb.max.z - aabb.min.z) * 0.5f},
+	};
+	return IsVisible(frustum, center, axes);
+}
+
+inline bool IsVisible(const Frustum& frustum, const OBB& obb) {
+	const Vector3 axes[3] = {Multiply(obb.size.x, obb.orientations[0]), Multiply(obb.size.y, obb.orientations[1]), Multiply(obb.size.z, obb.orientations[2])};
+	return IsVisible(frustum, obb.center, axes);
+}
+
+/// <summary>
+/// 点の集まり（三角形や線分など）の凸包が視錐台と重なり得るか。
+/// どれか1枚の平面の外側に全部の点があるときだけ false
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="points">点の配列</param>
+/// <param name="count">点の数</param>
+bool IsVisible(const Frustum& frustum, const Vector3* points, size_t count);
+
+//=== まとめて判定する（SIMDで4個ずつ処理） ===//
+
+/// <summary>
+/// 球の配列をまとめて判定する
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="spheres">球の配列</param>
+/// <param name="count">個数</param>
+/// <param name="visible">各球が見えるかの書き込み先</param>
+/// <returns>見える球の数</returns>
+size_t CullSpheres(const Frustum& frustum, const Sphere* spheres, size_t count, bool* visible);
+
+/// <summary>
+/// AABBの配列をまとめて判定する
+/// </summary>
+/// <returns>見えるAABBの数</returns>
+size_t CullAABBs(const Frustum& frustum, const AABB* aabbs, size_t count, bool* visible);
+
+/// <summary>
+/// OBBの配列をまとめて判定する
+/// </summary>
+/// <returns>見えるOBBの数</returns>
+size_t CullOBBs(const Frustum& frustum, const OBB* obbs, size_t count, bool* visible);
@@ -0,0 +1,70 @@
+#include "Geometry.h"
+#include <algorithm>
+#include <cmath>
+
+bool IsCollision(const AABB& aabb, const Segment& segment) {
+	float tMin = 0.0f;
+	float tMax = 1.0f;
+
+	Vector3 p = segment.origin;
+	Vector3 d = segment.diff;
+
+	for (int i = 0; i < 3; ++i) {
+		float start = (&p.x)[i];
+		float direction = (&d.x)[i];
+		float minVal = (&aabb.min.x)[i];
+		float maxVal = (&aabb.max.x)[i];
+
+		if (fabsf(direction) < 1e-6f) {
+			// 平行な場合：内側にあるか
+			if (start < minVal || start > maxVal) {
+				return false;
+			}
+		} else {
+			float t1 = (minVal - start) / direction;
+			float t2 = (maxVal - start) / direction;
+			if (t1 > t2)
+				std::swap(t1, t2);
+			tMin = (std::max)(tMin, t1);
+			tMax = (std::min)(tMax, t2);
+			if (tMin > tMax)
+				return false;
+		}
+	}
+	return true;
+}
+
+bool IsCollisionOBBLine(const OBB& obb, const Matrix4x4& obbWorldMatrix, const Segment& worldsegment) {
+	// ワールド行列はアフィンなので3x3だけの逆行列で済む
+	Matrix4x4 obbInverse = InverseAffine(obbWorldMatrix);
+
+	Vector3 localOrigin = Transform(worldsegment.origin, obbInverse);
+	Vector3 localEnd = Transform(Add(worldsegment.origin, worldsegment.diff), obbInverse);
+
+	Segment localLine;
+	localLine.origin = localOrigin;
+	localLine.diff = Subtract(localEnd, localOrigin);
+
+	AABB localAABB = {
+	    {-obb.size.x, -obb.size.y, -obb.size.z},
+        {+obb.size.x, +obb.size.y, +obb.size.z}
+    };
+
+	return IsCollision(localAABB, localLine);
+}
+
+void SetOBBRotation(OBB& obb, const Quaternion& rotation) {
+	const Vector3 axes[3] = {
+	    {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    };
+	RotateVectors(axes, 3, rotation, obb.orientations);
+}
+
+Matrix4x4 MakeOBBWorldMatrix(const OBB& obb) {
+	return {
+	    obb.orientations[0].x, obb.orientations[0].y, obb.orientations[0].z, 0.0f, obb.orientations[1].x, obb.orientations[1].y, obb.orientations[1].z, 0.0f,
+	    obb.orientations[2].x, obb.orientations[2].y, obb.orientations[2].z, 0.0f, obb.center.x,          obb.center.y,          obb.center.z,          1.0f,
+	};
+}
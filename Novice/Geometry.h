@@ -0,0 +1,64 @@
+#pragma once
+#include "MathFunction.h"
+#include "Quaternion.h"
+
+struct Sphere {
+	Vector3 center; // 中心点
+	float radius;   // 半径
+};
+
+struct Plane {
+	Vector3 normal; // 法線
+	float distance; // 距離
+};
+
+struct Segment {
+	Vector3 origin; // 原点
+	Vector3 diff;   // 終点への差分ベクトル
+};
+
+struct Triangle {
+	Vector3 vertices[3]; // 原点
+};
+
+struct AABB {
+	Vector3 min; // 最小点
+	Vector3 max; // 最大点
+};
+
+struct OBB {
+	Vector3 center;          // 中心点
+	Vector3 orientations[3]; // 座標軸。正規化・直行必要
+	Vector3 size;            // 中心点から面までの距離
+};
+
+/// <summary>
+/// AABBと線分の当たり判定（スラブ法）
+/// </summary>
+/// <param name="aabb">AABB</param>
+/// <param name="segment">線分</param>
+/// <returns>当たっているか</returns>
+bool IsCollision(const AABB& aabb, const Segment& segment);
+
+/// <summary>
+/// OBBと線分の当たり判定（線分をOBBのローカル空間へ移してAABBとして判定する）
+/// </summary>
+/// <param name="obb">OBB</param>
+/// <param name="obbWorldMatrix">OBBのワールド行列</param>
+/// <param name="worldsegment">ワールド空間の線分</param>
+/// <returns>当たっているか</returns>
+bool IsCollisionOBBLine(const OBB& obb, const Matrix4x4& obbWorldMatrix, const Segment& worldsegment);
+
+/// <summary>
+/// OBBの座標軸を回転から設定する（オイラー角から3つの回転行列を作って掛けるより軽い）
+/// </summary>
+/// <param name="obb">OBB</param>
+/// <param name="rotation">回転（単位クォータニオン）</param>
+void SetOBBRotation(OBB& obb, const Quaternion& rotation);
+
+/// <summary>
+/// OBBのワールド行列（座標軸と中心点から作る。拡縮は含まない）
+/// </summary>
+/// <param name="obb">OBB</param>
+/// <returns>ワールド行列</returns>
+Matrix4x4 MakeOBBWorldMatrix(const OBB& obb);
@@ -0,0 +1,8 @@
+#include "LineBatch.h"
+
+void LineBatch::Flush() {
+	if (flushFunction_ && !lines_.empty()) {
+		flushFunction_(lines_.data(), lines_.size());
+	}
+	lines_.clear();
+}
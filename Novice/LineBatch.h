@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// スクリーン座標の線1本（端点と RGBA の色、20バイト）
+struct ScreenLine {
+	int32_t x1;
+	int32_t y1;
+	int32_t x2;
+	int32_t y2;
+	uint32_t color;
+};
+
+// まとめた線を受け取る関数（描画側が1回の呼び出しで全部を送る）
+using LineFlushFunction = void (*)(const ScreenLine* lines, size_t count);
+
+/// <summary>
+/// 1フレーム分のスクリーン座標の線を連続したバッファにためておき、フレームの最後にまとめて渡す。
+/// バッファは Flush で空にしても確保し直さないので、毎フレーム同じものを使い回す
+/// </summary>
+class LineBatch {
+public:
+	LineBatch() = default;
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="flushFunction">Flush で線を渡す先</param>
+	explicit LineBatch(LineFlushFunction flushFunction) : flushFunction_(flushFunction) {}
+
+	/// <summary>
+	/// Flush で線を渡す先を設定する（nullptr なら捨てる）
+	/// </summary>
+	void SetFlushFunction(LineFlushFunction flushFunction) { flushFunction_ = flushFunction; }
+
+	/// <summary>
+	/// 線を追加する
+	/// </summary>
+	void Add(int x1, int y1, int x2, int y2, uint32_t color) { lines_.push_back({x1, y1, x2, y2, color}); }
+
+	/// <summary>
+	/// 予め容量を確保しておく
+	/// </summary>
+	/// <param name="count">線の数</param>
+	void Reserve(size_t count) { lines_.reserve(count); }
+
+	/// <summary>
+	/// ためた線をまとめて渡して空にする（EndFrame の前に1回呼ぶ）
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// 渡さずに空にする
+	/// </summary>
+	void Clear() { lines_.clear(); }
+
+	/// <summary>
+	/// ためた線を other と入れ替える（バッファごと入れ替えるのでコピーしない。渡す先はそのまま）
+	/// </summary>
+	void Swap(LineBatch& other) { lines_.swap(other.lines_); }
+
+	size_t GetCount() const { return lines_.size(); }
+	const ScreenLine* GetLines() const { return lines_.data(); }
+
+private:
+	std::vector<ScreenLine> lines_;
+	LineFlushFunction flushFunction_ = nullptr;
+};
@@ -0,0 +1,359 @@
+#include "LineRasterizer.h"
+#include "MathSimd.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+
+// 1つのチャンクで振り分ける線の数の目安（少なければスレッドに分けない）
+const size_t kLinesPerChunk = 4096;
+
+// 扱える座標の絶対値の上限（途中の積が64ビットに収まる範囲。ScreenProjector のガードバンドよりずっと広い）
+const int64_t kMaxCoordinate = int64_t(1) << 24;
+
+// タイルの範囲（right / bottom は含まない）
+struct TileRect {
+	int left;
+	int top;
+	int right;
+	int bottom;
+};
+
+// 連続した count 画素を同じ色で塗る
+void FillSpan(uint32_t* pixels, size_t count, uint32_t color) {
+	size_t i = 0;
+#if defined(MATH_SIMD_SSE)
+	const __m128i color4 = _mm_set1_epi32(static_cast<int>(color));
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), color4);
+	}
+#endif
+	for (; i < count; ++i) {
+		pixels[i] = color;
+	}
+}
+
+// dst に color を weight / 255 の割合で重ねる（RGBA の4成分とも dst + (color - dst) × weight / 255 を四捨五入）。
+// 2成分ずつ16ビットに広げて掛け、x / 255 の四捨五入は (x + 128 + ((x + 128) >> 8)) >> 8 で求める
+uint32_t Blend(uint32_t dst, uint32_t color, uint32_t weight) {
+	const uint32_t kMask = 0x00FF00FF;
+	const uint32_t inverse = 255 - weight;
+	uint32_t rb = (color & kMask) * weight + (dst & kMask) * inverse + 0x00800080;
+	uint32_t ga = ((color >> 8) & kMask) * weight + ((dst >> 8) & kMask) * inverse + 0x00800080;
+	rb = ((rb + ((rb >> 8) & kMask)) >> 8) & kMask;
+	ga = ((ga + ((ga >> 8) & kMask)) >> 8) & kMask;
+	return rb | (ga << 8);
+}
+
+// 線を主軸（長い方の軸）m と副軸 n に読み替えたもの。m1 <= m2 にそろえてあるので、
+// 両端を入れ替えて渡しても同じ画素になる
+struct MajorLine {
+	bool xMajor;
+	int64_t m1;
+	int64_t n1;
+	int64_t length; // m2 - m1
+	int64_t delta;  // n2 - n1
+	int64_t mLo;    // タイルの主軸の範囲（両端を含む）
+	int64_t mHi;
+	int64_t nLo; // タイルの副軸の範囲（両端を含む）
+	int64_t nHi;
+};
+
+MajorLine MakeMajorLine(const ScreenLine& line, const TileRect& tile) {
+	int64_t x1 = line.x1, y1 = line.y1, x2 = line.x2, y2 = line.y2;
+	MajorLine major;
+	major.xMajor = std::llabs(x2 - x1) >= std::llabs(y2 - y1);
+	int64_t m2, n2;
+	if (major.xMajor) {
+		major.m1 = x1, major.n1 = y1, m2 = x2, n2 = y2;
+		major.mLo = tile.left, major.mHi = tile.right - 1, major.nLo = tile.top, major.nHi = tile.bottom - 1;
+	} else {
+		major.m1 = y1, major.n1 = x1, m2 = y2, n2 = x2;
+		major.mLo = tile.top, major.mHi = tile.bottom - 1, major.nLo = tile.left, major.nHi = tile.right - 1;
+	}
+	if (m2 < major.m1) {
+		std::swap(major.m1, m2);
+		std::swap(major.n1, n2);
+	}
+	major.length = m2 - major.m1;
+	major.delta = n2 - major.n1;
+	return major;
+}
+
+// Bresenham。主軸の t 番目の画素の副軸は n1 + sign × floor((2 t |delta| + length) / (2 length)) で、
+// タイルに入る位置から直接求めるので、どのタイルで描いても線全体で描いたときと同じ画素になる
+void DrawAliasedLine(const ScreenLine& line, const TileRect& tile, uint32_t* pixels, int width) {
+	const MajorLine l = MakeMajorLine(line, tile);
+	const size_t stride = static_cast<size_t>(width);
+	auto pixelAt = [&](int64_t m, int64_t n) -> uint32_t& {
+		return l.xMajor ? pixels[static_cast<size_t>(n) * stride + static_cast<size_t>(m)] : pixels[static_cast<size_t>(m) * stride + static_cast<size_t>(n)];
+	};
+
+	if (l.length == 0) {
+		if (l.m1 >= l.mLo && l.m1 <= l.mHi && l.n1 >= l.nLo && l.n1 <= l.nHi) {
+			pixelAt(l.m1, l.n1) = line.color;
+		}
+		return;
+	}
+
+	const int64_t end = (std::min)(l.m1 + l.length, l.mHi);
+	int64_t t = (std::max)(l.m1, l.mLo) - l.m1;
+	const int64_t step = l.delta > 0 ? 1 : (l.delta < 0 ? -1 : 0);
+	const int64_t twoDelta = 2 * std::llabs(l.delta);
+	const int64_t twoLength = 2 * l.length;
+
+	// 副軸がまだタイルの手前なら、タイルに入る t まで飛ばす
+	if (twoDelta > 0) {
+		int64_t rows = step > 0 ? l.nLo - l.n1 : l.n1 - l.nHi;
+		if (rows > 0) {
+			t = (std::max)(t, (twoLength * rows - l.length + twoDelta - 1) / twoDelta);
+		}
+	}
+	int64_t m = l.m1 + t;
+	if (m > end) {
+		return;
+	}
+	// t == 0（線がこのタイルの中から始まる）なら割り算はいらない
+	int64_t n = l.n1;
+	int64_t error = l.length;
+	if (t != 0) {
+		int64_t numerator = t * twoDelta + l.length;
+		n += step * (numerator / twoLength);
+		error = numerator % twoLength;
+	}
+
+	// 副軸が同じ画素の並び（x が主軸なら横、y が主軸なら縦）ごとにまとめて塗る
+	while (m <= end && n >= l.nLo && n <= l.nHi) {
+		int64_t run = end - m + 1;
+		if (twoDelta > 0) {
+			run = (std::min)(run, (twoLength - 1 - error) / twoDelta + 1);
+		}
+		uint32_t* first = &pixelAt(m, n);
+		if (l.xMajor) {
+			FillSpan(first, static_cast<size_t>(run), line.color);
+		} else {
+			for (int64_t i = 0; i < run; ++i) {
+				first[static_cast<size_t>(i) * stride] = line.color;
+			}
+		}
+		m += run;
+		error += run * twoDelta - twoLength;
+		n += step;
+	}
+}
+
+// 1列分の Wu の2画素（p0 に weight0、p1 に weight1 の割合で color を重ねる）
+void BlendPair(uint32_t* p0, uint32_t* p1, uint32_t color, uint32_t weight0, uint32_t weight1) {
+#if defined(MATH_SIMD_SSE)
+	// 2画素 × 4成分を16ビットに広げて Blend と同じ式をまとめて計算する
+	const __m128i zero = _mm_setzero_si128();
+	__m128i dst = _mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(*p0)), _mm_cvtsi32_si128(static_cast<int>(*p1)));
+	dst = _mm_unpacklo_epi8(dst, zero);
+	const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+	const __m128i weight = _mm_set_epi16(
+	    static_cast<short>(weight1), static_cast<short>(weight1), static_cast<short>(weight1), static_cast<short>(weight1), static_cast<short>(weight0), static_cast<short>(weight0),
+	    static_cast<short>(weight0), static_cast<short>(weight0));
+	const __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), weight);
+	__m128i x = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(src, weight), _mm_mullo_epi16(dst, inverse)), _mm_set1_epi16(128));
+	x = _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	x = _mm_packus_epi16(x, zero);
+	*p0 = static_cast<uint32_t>(_mm_cvtsi128_si32(x));
+	*p1 = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x, 4)));
+#else
+	*p0 = Blend(*p0, color, weight0);
+	*p1 = Blend(*p1, color, weight1);
+#endif
+}
+
+// Wu。主軸の各画素で線が通る副軸の位置を 1/256 画素単位で求め、上下2画素にかかる割合で重ねる。
+// 位置は floor(256 × delta × t / length) を Bresenham と同じく整数の商と余りで進めるので、
+// タイルに入る位置から直接求めた値と一致する。端点は整数座標なので、端の減光はしない
+void DrawAntialiasedLine(const ScreenLine& line, const TileRect& tile, uint32_t* pixels, int width) {
+	const MajorLine l = MakeMajorLine(line, tile);
+	const size_t stride = static_cast<size_t>(width);
+	const uint32_t alpha = line.color & 0xFF;
+	auto pixelAt = [&](int64_t m, int64_t n) -> uint32_t& {
+		return l.xMajor ? pixels[static_cast<size_t>(n) * stride + static_cast<size_t>(m)] : pixels[static_cast<size_t>(m) * stride + static_cast<size_t>(n)];
+	};
+	auto plot = [&](int64_t m, int64_t n, uint32_t weight) {
+		if (weight != 0 && n >= l.nLo && n <= l.nHi) {
+			uint32_t& pixel = pixelAt(m, n);
+			pixel = Blend(pixel, line.color, weight);
+		}
+	};
+
+	if (l.length == 0) {
+		if (l.m1 >= l.mLo && l.m1 <= l.mHi) {
+			plot(l.m1, l.n1, alpha);
+		}
+		return;
+	}
+
+	const int64_t end = (std::min)(l.m1 + l.length, l.mHi);
+	int64_t t = (std::max)(l.m1, l.mLo) - l.m1;
+	const int64_t step = l.delta * 256;
+	// 1/256 画素単位で、副軸の位置が1画素分進むのに必要な t（副軸がまだタイルの手前なら飛ばす）
+	if (l.delta > 0 && l.nLo - 1 > l.n1) {
+		t = (std::max)(t, ((l.nLo - 1 - l.n1) * 256 * l.length) / step);
+	} else if (l.delta < 0 && l.nHi + 1 < l.n1) {
+		t = (std::max)(t, ((l.n1 - l.nHi - 1) * 256 * l.length) / -step);
+	}
+	int64_t m = l.m1 + t;
+	if (m > end) {
+		return;
+	}
+
+	// position = floor(step × t / length)（負の値も床関数）、remainder はその余り（0 以上 length 未満）
+	auto floorDivide = [](int64_t a, int64_t b, int64_t& remainder) {
+		int64_t q = a / b;
+		remainder = a - q * b;
+		if (remainder < 0) {
+			remainder += b;
+			--q;
+		}
+		return q;
+	};
+	int64_t stepRemainder;
+	const int64_t stepQuotient = floorDivide(step, l.length, stepRemainder);
+	int64_t remainder;
+	int64_t position = t == 0 ? (remainder = 0, 0) : floorDivide(step * t, l.length, remainder);
+	position += l.n1 * 256;
+
+	for (; m <= end; ++m) {
+		const int64_t n = position >> 8;
+		const uint32_t fraction = static_cast<uint32_t>(position & 0xFF);
+		if ((l.delta >= 0 && n > l.nHi) || (l.delta <= 0 && n + 1 < l.nLo)) {
+			break;
+		}
+		const uint32_t weight0 = ((256 - fraction) * alpha + 128) >> 8;
+		const uint32_t weight1 = (fraction * alpha + 128) >> 8;
+		if (n >= l.nLo && n + 1 <= l.nHi) {
+			BlendPair(&pixelAt(m, n), &pixelAt(m, n + 1), line.color, weight0, weight1);
+		} else {
+			plot(m, n, weight0);
+			plot(m, n + 1, weight1);
+		}
+		position += stepQuotient;
+		remainder += stepRemainder;
+		if (remainder >= l.length) {
+			remainder -= l.length;
+			++position;
+		}
+	}
+}
+
+} // namespace
+
+LineRasterizer::LineRasterizer(ThreadPool* threadPool) : threadPool_(threadPool ? threadPool : ThreadPool::GetInstance()) {}
+
+void LineRasterizer::Rasterize(const ScreenLine* lines, size_t count, Framebuffer& target) {
+	width_ = target.GetWidth();
+	height_ = target.GetHeight();
+	tilesX_ = (width_ + kTileSize - 1) / kTileSize;
+	tilesY_ = (height_ + kTileSize - 1) / kTileSize;
+	const size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+	binnedCount_ = 0;
+	if (count == 0 || tileCount == 0) {
+		return;
+	}
+
+	// 線を順番のまま chunkCount_ 個に分け、チャンクごとに別々のビンへ振り分ける（ロック不要）
+	size_t maxChunks = static_cast<size_t>(threadPool_->GetWorkerCount()) + 1;
+	chunkCount_ = (std::min)((count + kLinesPerChunk - 1) / kLinesPerChunk, maxChunks);
+	if (bins_.size() < chunkCount_ * tileCount) {
+		bins_.resize(chunkCount_ * tileCount);
+	}
+	for (size_t i = 0; i < chunkCount_ * tileCount; ++i) {
+		bins_[i].clear();
+	}
+	threadPool_->ParallelFor(chunkCount_, 1, [&](size_t begin, size_t end) {
+		for (size_t chunk = begin; chunk < end; ++chunk) {
+			BinLines(lines, count * chunk / chunkCount_, count * (chunk + 1) / chunkCount_, chunk);
+		}
+	});
+	for (size_t i = 0; i < chunkCount_ * tileCount; ++i) {
+		binnedCount_ += bins_[i].size();
+	}
+
+	// タイル同士は画素が重ならないので、そのまま並列に描ける
+	threadPool_->ParallelFor(tileCount, 1, [&](size_t begin, size_t end) {
+		for (size_t tile = begin; tile < end; ++tile) {
+			RasterizeTile(lines, static_cast<int>(tile), target);
+		}
+	});
+}
+
+void LineRasterizer::BinLines(const ScreenLine* lines, size_t begin, size_t end, size_t chunk) {
+	std::vector<uint32_t>* bins = &bins_[chunk * static_cast<size_t>(tilesX_) * tilesY_];
+	// Wu は線から1画素離れた画素にも描くので、その分広げて振り分ける
+	const int64_t margin = mode_ == LineRasterMode::kAntialiased ? 1 : 0;
+
+	for (size_t i = begin; i < end; ++i) {
+		const ScreenLine& line = lines[i];
+		int64_t minX = (std::min)(line.x1, line.x2) - margin;
+		int64_t maxX = (std::max)(line.x1, line.x2) + margin;
+		int64_t minY = (std::min)(line.y1, line.y2) - margin;
+		int64_t maxY = (std::max)(line.y1, line.y2) + margin;
+		if (maxX < 0 || maxY < 0 || minX >= width_ || minY >= height_) {
+			continue;
+		}
+		if (minX < -kMaxCoordinate || maxX > kMaxCoordinate || minY < -kMaxCoordinate || maxY > kMaxCoordinate) {
+			continue;
+		}
+		int tileLeft = static_cast<int>((std::max)(minX, int64_t(0)) / kTileSize);
+		int tileRight = static_cast<int>((std::min)(maxX, int64_t(width_ - 1)) / kTileSize);
+		int tileTop = static_cast<int>((std::max)(minY, int64_t(0)) / kTileSize);
+		int tileBottom = static_cast<int>((std::min)(maxY, int64_t(height_ - 1)) / kTileSize);
+		uint32_t index = static_cast<uint32_t>(i);
+		if (tileLeft == tileRight && tileTop == tileBottom) {
+			bins[tileTop * tilesX_ + tileLeft].push_back(index);
+			continue;
+		}
+
+		// 範囲の中でも線が通らないタイルは外す。
+		// 描く画素は線から1画素未満なので、タイルを1画素広げた四角の角が全部線の同じ側にあれば描く画素はない
+		const int64_t edgeX = static_cast<int64_t>(line.x2) - line.x1;
+		const int64_t edgeY = static_cast<int64_t>(line.y2) - line.y1;
+		auto side = [&](int64_t x, int64_t y) { return edgeY * (x - line.x1) - edgeX * (y - line.y1); };
+		for (int ty = tileTop; ty <= tileBottom; ++ty) {
+			int64_t top = int64_t(ty) * kTileSize - 1;
+			int64_t bottom = int64_t(ty + 1) * kTileSize;
+			for (int tx = tileLeft; tx <= tileRight; ++tx) {
+				int64_t left = int64_t(tx) * kTileSize - 1;
+				int64_t right = int64_t(tx + 1) * kTileSize;
+				int64_t a = side(left, top), b = side(right, top), c = side(left, bottom), d = side(right, bottom);
+				if ((a > 0 && b > 0 && c > 0 && d > 0) || (a < 0 && b < 0 && c < 0 && d < 0)) {
+					continue;
+				}
+				bins[ty * tilesX_ + tx].push_back(index);
+			}
+		}
+	}
+}
+
+void LineRasterizer::RasterizeTile(const ScreenLine* lines, int tileIndex, Framebuffer& target) const {
+	const int tx = tileIndex % tilesX_;
+	const int ty = tileIndex / tilesX_;
+	const TileRect tile = {
+	    tx * kTileSize,
+	    ty * kTileSize,
+	    (std::min)((tx + 1) * kTileSize, width_),
+	    (std::min)((ty + 1) * kTileSize, height_),
+	};
+	const size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+	uint32_t* pixels = target.GetPixels();
+
+	// チャンクは線の順に並んでいるので、前から描けば渡した順に重なる
+	for (size_t chunk = 0; chunk < chunkCount_; ++chunk) {
+		for (uint32_t index : bins_[chunk * tileCount + tileIndex]) {
+			if (mode_ == LineRasterMode::kAntialiased) {
+				DrawAntialiasedLine(lines[index], tile, pixels, width_);
+			} else {
+				DrawAliasedLine(lines[index], tile, pixels, width_);
+			}
+		}
+	}
+}
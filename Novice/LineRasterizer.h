@@ -0,0 +1,64 @@
+#pragma once
+#include "Framebuffer.h"
+#include "LineBatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+// 線の描き方
+enum class LineRasterMode {
+	kAliased,     // Bresenham。色をそのまま書く（Novice::DrawLine と同じ見た目）
+	kAntialiased, // Wu。画素にかかる割合 × 色のアルファで重ねる
+};
+
+/// <summary>
+/// スクリーン座標の線をまとめて Framebuffer に描くソフトウェアラスタライザ。
+/// 線を kTileSize 四方のタイルに振り分けてから、タイルごとに ThreadPool で並列に描く。
+/// 1本の線の画素はタイルの分け方やスレッド数によらず同じで、重なった線は渡した順に上書きされる
+/// </summary>
+class LineRasterizer {
+public:
+	// タイルの一辺（画素）
+	static constexpr int kTileSize = 64;
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="threadPool">使うスレッドプール（nullptr なら ThreadPool::GetInstance()）</param>
+	explicit LineRasterizer(ThreadPool* threadPool = nullptr);
+
+	void SetMode(LineRasterMode mode) { mode_ = mode; }
+	LineRasterMode GetMode() const { return mode_; }
+
+	/// <summary>
+	/// 線を描く（画面の外にはみ出した部分は捨てる。画面は消さない）
+	/// </summary>
+	/// <param name="lines">線（LineBatch::GetLines() など）</param>
+	/// <param name="count">線の数</param>
+	/// <param name="target">描き込む画面</param>
+	void Rasterize(const ScreenLine* lines, size_t count, Framebuffer& target);
+
+	// 直前の Rasterize でタイルに振り分けた数（1本が複数のタイルにかかれば、その分数える）
+	size_t GetBinnedCount() const { return binnedCount_; }
+
+private:
+	// lines[begin, end) を bins_[chunk] の各タイルへ振り分ける
+	void BinLines(const ScreenLine* lines, size_t begin, size_t end, size_t chunk);
+
+	// タイル1枚を描く
+	void RasterizeTile(const ScreenLine* lines, int tileIndex, Framebuffer& target) const;
+
+	ThreadPool* threadPool_;
+	LineRasterMode mode_ = LineRasterMode::kAliased;
+
+	// [チャンク × タイル] ごとの線の番号。チャンクは線を順に分けたもので、スレッドごとに別々に書き込む
+	std::vector<std::vector<uint32_t>> bins_;
+	size_t chunkCount_ = 0;
+	int tilesX_ = 0;
+	int tilesY_ = 0;
+	int width_ = 0;
+	int height_ = 0;
+	size_t binnedCount_ = 0;
+};
@@ -0,0 +1,44 @@
+#include "Lod.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+
+LodSettings lodSettings;
+
+// 必要な分割数（小数）を、前の分割数とヒステリシスを考えて整数にする
+uint32_t SelectDivision(float required, uint32_t previous, float hysteresis, uint32_t minDivision, uint32_t maxDivision) {
+	uint32_t division = static_cast<uint32_t>(std::ceil(std::min(required, static_cast<float>(maxDivision))));
+	if (previous != 0 && division < previous && required > static_cast<float>(previous) * (1.0f - hysteresis)) {
+		// 減らせるが、まだ余裕の範囲内なので前の分割数のまま
+		division = previous;
+	}
+	return std::clamp(division, minDivision, maxDivision);
+}
+
+} // namespace
+
+void SetLodSettings(const LodSettings& settings) { lodSettings = settings; }
+
+const LodSettings& GetLodSettings() { return lodSettings; }
+
+uint32_t SelectSphereSubdivision(float projectedRadius, uint32_t previous, const LodSettings& settings) {
+	float required = static_cast<float>(settings.maxSphereSubdivision);
+	if (projectedRadius <= settings.tolerance) {
+		required = 0.0f;
+	} else if (std::isfinite(projectedRadius)) {
+		// r(1 - cos(π / n)) <= tolerance を n について解く
+		required = std::numbers::pi_v<float> / std::acos(1.0f - settings.tolerance / projectedRadius);
+	}
+	return SelectDivision(required, previous, settings.hysteresis, settings.minSphereSubdivision, settings.maxSphereSubdivision);
+}
+
+uint32_t SelectBezierDivision(float controlPolygonLength, uint32_t previous, const LodSettings& settings) {
+	float required = static_cast<float>(settings.maxBezierDivision);
+	if (std::isfinite(controlPolygonLength)) {
+		// length / (4n²) <= tolerance を n について解く
+		required = std::sqrt(controlPolygonLength / (4.0f * settings.tolerance));
+	}
+	return SelectDivision(required, previous, settings.hysteresis, settings.minBezierDivision, settings.maxBezierDivision);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+// DrawBezier の分割数の上限
+const uint32_t kMaxBezierDivision = 64;
+
+/// <summary>
+/// 画面上の大きさから分割数を選ぶときの設定
+/// </summary>
+struct LodSettings {
+	float tolerance = 0.5f;                          // 本当の曲線と折れ線のずれの許容量（ピクセル）
+	float hysteresis = 0.2f;                         // 分割数を減らすときの余裕（割合）。境目でちらつかないようにする
+	uint32_t minSphereSubdivision = 4;               // 球の分割数の下限
+	uint32_t maxSphereSubdivision = 32;              // 球の分割数の上限（kMaxSphereSubdivision 以下）
+	uint32_t minBezierDivision = 2;                  // ベジエ曲線の分割数の下限
+	uint32_t maxBezierDivision = kMaxBezierDivision; // ベジエ曲線の分割数の上限
+};
+
+/// <summary>
+/// 既定の設定を変える（LodSettings を渡さない関数はこの設定を使う）
+/// </summary>
+void SetLodSettings(const LodSettings& settings);
+
+const LodSettings& GetLodSettings();
+
+/// <summary>
+/// 球の分割数を画面上の半径から選ぶ。
+/// 緯線の弦と円のずれ r(1 - cos(π / n)) が許容量以下になる最小の n にする。
+/// 増やすのはすぐ、減らすのは必要な分割数が previous × (1 - hysteresis) を下回ってから
+/// </summary>
+/// <param name="projectedRadius">画面上の半径（ピクセル）</param>
+/// <param name="previous">前のフレームの分割数（初めてなら0）</param>
+/// <param name="settings">設定</param>
+/// <returns>分割数</returns>
+uint32_t SelectSphereSubdivision(float projectedRadius, uint32_t previous, const LodSettings& settings = GetLodSettings());
+
+/// <summary>
+/// 2次ベジエ曲線の分割数を制御点の折れ線の長さ（ピクセル）から選ぶ。
+/// 均等に n 分割したときのずれは |p0 - 2p1 + p2| / (4n²) 以下で、|p0 - 2p1 + p2| は折れ線の長さ以下なので、
+/// 長さ / (4n²) が許容量以下になる最小の n にする。ヒステリシスは球と同じ
+/// </summary>
+/// <param name="controlPolygonLength">|p1 - p0| + |p2 - p1|（ピクセル）</param>
+/// <param name="previous">前のフレームの分割数（初めてなら0）</param>
+/// <param name="settings">設定</param>
+/// <returns>分割数</returns>
+uint32_t SelectBezierDivision(float controlPolygonLength, uint32_t previous, const LodSettings& settings = GetLodSettings());
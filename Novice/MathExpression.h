@@ -0,0 +1,94 @@
+#pragma once
+// MATH_EXPRESSION_TEMPLATES を定義したときに MathFunction.h から読み込まれる。直接インクルードしない。
+//
+// Vector3 の演算子が計算結果ではなく「式」を返し、Vector3 に代入・変換された時点で
+// 成分ごとに1回だけまとめて計算する。
+// 例えば a + b * s - c は途中の Vector3 を作らず、x / y / z それぞれ1本の式になる。
+// 式は値で保持するので、auto で受け取っても元の変数が消えて壊れることはない。
+#include <concepts>
+#include <type_traits>
+
+namespace MathExpression {
+
+template<typename T> struct IsExpression : std::false_type {};
+
+// 式テンプレートの型
+template<typename T>
+concept Expression = IsExpression<std::remove_cvref_t<T>>::value;
+
+// 演算子の対象になる型（Vector3 か式）
+template<typename T>
+concept Operand = Expression<T> || std::same_as<std::remove_cvref_t<T>, Vector3>;
+
+template<int kIndex> constexpr float Get(const Vector3& v) noexcept {
+	if constexpr (kIndex == 0) {
+		return v.x;
+	} else if constexpr (kIndex == 1) {
+		return v.y;
+	} else {
+		return v.z;
+	}
+}
+
+template<int kIndex, Expression E> constexpr float Get(const E& e) noexcept { return e.template Get<kIndex>(); }
+
+// 式の共通部分（成分ごとの値と Vector3 への変換）
+template<typename Derived> struct ExpressionBase {
+	constexpr Vector3 Evaluate() const noexcept {
+		const Derived& self = static_cast<const Derived&>(*this);
+		return {self.template Get<0>(), self.template Get<1>(), self.template Get<2>()};
+	}
+	constexpr operator Vector3() const noexcept { return Evaluate(); }
+};
+
+template<typename L, typename R> struct AddExpression : ExpressionBase<AddExpression<L, R>> {
+	L lhs;
+	R rhs;
+	constexpr AddExpression(const L& l, const R& r) noexcept : lhs(l), rhs(r) {}
+	template<int kIndex> constexpr float Get() const noexcept { return MathExpression::Get<kIndex>(lhs) + MathExpression::Get<kIndex>(rhs); }
+};
+
+template<typename L, typename R> struct SubtractExpression : ExpressionBase<SubtractExpression<L, R>> {
+	L lhs;
+	R rhs;
+	constexpr SubtractExpression(const L& l, const R& r) noexcept : lhs(l), rhs(r) {}
+	template<int kIndex> constexpr float Get() const noexcept { return MathExpression::Get<kIndex>(lhs) - MathExpression::Get<kIndex>(rhs); }
+};
+
+template<typename V> struct ScaleExpression : ExpressionBase<ScaleExpression<V>> {
+	float scale;
+	V vector;
+	constexpr ScaleExpression(float s, const V& v) noexcept : scale(s), vector(v) {}
+	template<int kIndex> constexpr float Get() const noexcept { return scale * MathExpression::Get<kIndex>(vector); }
+};
+
+template<typename V> struct NegateExpression : ExpressionBase<NegateExpression<V>> {
+	V vector;
+	constexpr explicit NegateExpression(const V& v) noexcept : vector(v) {}
+	template<int kIndex> constexpr float Get() const noexcept { return -MathExpression::Get<kIndex>(vector); }
+};
+
+template<typename L, typename R> struct IsExpression<AddExpression<L, R>> : std::true_type {};
+template<typename L, typename R> struct IsExpression<SubtractExpression<L, R>> : std::true_type {};
+template<typename V> struct IsExpression<ScaleExpression<V>> : std::true_type {};
+template<typename V> struct IsExpression<NegateExpression<V>> : std::true_type {};
+
+} // namespace MathExpression
+
+template<MathExpression::Operand L, MathExpression::Operand R> constexpr auto operator+(const L& lhs, const R& rhs) noexcept {
+	return MathExpression::AddExpression<std::remove_cvref_t<L>, std::remove_cvref_t<R>>(lhs, rhs);
+}
+
+template<MathExpression::Operand L, MathExpression::Operand R> constexpr auto operator-(const L& lhs, const R& rhs) noexcept {
+	return MathExpression::SubtractExpression<std::remove_cvref_t<L>, std::remove_cvref_t<R>>(lhs, rhs);
+}
+
+template<MathExpression::Operand V> constexpr auto operator*(float s, const V& v) noexcept { return MathExpression::ScaleExpression<std::remove_cvref_t<V>>(s, v); }
+
+template<MathExpression::Operand V> constexpr auto operator*(const V& v, float s) noexcept { return MathExpression::ScaleExpression<std::remove_cvref_t<V>>(s, v); }
+
+template<MathExpression::Operand V> constexpr auto operator/(const V& v, float s) noexcept { return MathExpression::ScaleExpression<std::remove_cvref_t<V>>(1.0f / s, v); }
+
+template<MathExpression::Operand V> constexpr auto operator-(const V& v) noexcept { return MathExpression::NegateExpression<std::remove_cvref_t<V>>(v); }
+
+template<MathExpression::Operand V> constexpr Vector3 operator+(const V& v) noexcept { return v; }
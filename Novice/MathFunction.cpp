@@ -0,0 +1,626 @@
+#include "MathFunction.h"
+#include "FastMath.h"
+#include "MathSimd.h"
+#include <assert.h>
+#include <cmath>
+#include <math.h>
+
+const char* GetMathBackendName() {
+#if defined(MATH_SIMD_AVX2)
+	return "AVX2";
+#elif defined(MATH_SIMD_SSE)
+	return "SSE";
+#else
+	return "Scalar";
+#endif
+}
+
+float Length(const Vector3& v) {
+	// powf を使わず二乗和を直接計算する
+	return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+Vector3 Perpendicular(const Vector3& vector) {
+	if (vector.x != 0.0f || vector.y != 0.0f) {
+		return {-vector.y, vector.x, 0.0f};
+	}
+	return {0.0f, -vector.z, vector.y};
+}
+
+Vector3 Normalize(const Vector3& v) {
+	// 除算は逆数1回にまとめ、各成分は乗算で済ませる
+	float inverseLength = 1.0f / Length(v);
+	return {v.x * inverseLength, v.y * inverseLength, v.z * inverseLength};
+}
+
+Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t) {
+	Vector3 point1;
+	Vector3 point2;
+	point1 = {t * v1.x, t * v1.y, t * v1.z};
+	point2 = {(1.0f - t) * v2.x, (1.0f - t) * v2.y, (1.0f - t) * v2.z};
+	return {point1.x + point2.x, point1.y + point2.y, point1.z + point2.z};
+}
+
+Vector3 Bezier(const Vector3& p0, const Vector3& p1, const Vector3& p2, float t) {
+	Vector3 point01;
+	Vector3 point12;
+
+	point01 = Lerp(p0, p1, t);
+	point12 = Lerp(p1, p2, t);
+
+	return Lerp(point01, point12, t);
+}
+
+Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip) {
+	Matrix4x4 result;
+	result = {(1.0f / aspectRatio) * (1.0f / std::tan(fovY / 2.0f)), 0, 0, 0, 0, (1.0f / std::tan(fovY / 2.0f)), 0, 0, 0, 0, farClip / (farClip - nearClip), 1, 0, 0,
+	          (-nearClip * farClip) / (farClip - nearClip),           0};
+	return result;
+}
+
+Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth) {
+	Matrix4x4 result;
+	result = {width / 2.0f, 0, 0, 0, 0, -height / 2.0f, 0, 0, 0, 0, maxDepth - minDepth, 0, left + (width / 2.0f), top + (height / 2.0f), minDepth, 1};
+	return result;
+}
+
+Matrix4x4 MakeRotateXMatrix(float radian) {
+	// sin / cos はまとめて1回だけ求める（精度は既定の精度段階に従う）
+	float s, c;
+	FastMath::SinCos(radian, s, c);
+	return {1, 0, 0, 0, 0, c, s, 0, 0, -s, c, 0, 0, 0, 0, 1};
+}
+
+Matrix4x4 MakeRotateYMatrix(float radian) {
+	float s, c;
+	FastMath::SinCos(radian, s, c);
+	return {c, 0, -s, 0, 0, 1, 0, 0, s, 0, c, 0, 0, 0, 0, 1};
+}
+
+Matrix4x4 MakeRotateZMatrix(float radian) {
+	float s, c;
+	FastMath::SinCos(radian, s, c);
+	return {c, s, 0, 0, -s, c, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+}
+
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate) { return MathDetail::ComposeAffine<true, true>(scale, rotate, translate); }
+
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate, MatrixKind& kind) {
+	if (scale.x == 1.0f && scale.y == 1.0f && scale.z == 1.0f) {
+		kind = MatrixKind::Rigid;
+		return MakeRotateTranslateMatrix(rotate, translate);
+	}
+	kind = MatrixKind::Affine;
+	return MakeAffineMatrix(scale, rotate, translate);
+}
+
+Matrix4x4 Inverse(const Matrix4x4& m) {
+	bool isAffine = m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f && m.m[3][3] == 1.0f;
+	return isAffine ? InverseAffine(m) : InverseGeneral(m);
+}
+
+Matrix4x4 Inverse(const Matrix4x4& m, MatrixKind kind) {
+	switch (kind) {
+	case MatrixKind::Rigid:
+		return InverseRigid(m);
+	case MatrixKind::Affine:
+		return InverseAffine(m);
+	default:
+		return InverseGeneral(m);
+	}
+}
+
+Matrix4x4 InverseAffine(const Matrix4x4& m) {
+	// 左上3x3の余因子（転置済み）
+	float c00 = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+	float c01 = m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2];
+	float c02 = m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1];
+	float c10 = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+	float c11 = m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0];
+	float c12 = m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2];
+	float c20 = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+	float c21 = m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1];
+	float c22 = m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0];
+
+	float determinant = m.m[0][0] * c00 + m.m[0][1] * c10 + m.m[0][2] * c20;
+	assert(determinant != 0.0f);
+	float inv = 1.0f / determinant;
+
+	Matrix4x4 result;
+	result.m[0][0] = c00 * inv;
+	result.m[0][1] = c01 * inv;
+	result.m[0][2] = c02 * inv;
+	result.m[0][3] = 0.0f;
+	result.m[1][0] = c10 * inv;
+	result.m[1][1] = c11 * inv;
+	result.m[1][2] = c12 * inv;
+	result.m[1][3] = 0.0f;
+	result.m[2][0] = c20 * inv;
+	result.m[2][1] = c21 * inv;
+	result.m[2][2] = c22 * inv;
+	result.m[2][3] = 0.0f;
+
+	// 移動成分は -t × (3x3の逆行列)
+	const float* t = m.m[3];
+	result.m[3][0] = -(t[0] * result.m[0][0] + t[1] * result.m[1][0] + t[2] * result.m[2][0]);
+	result.m[3][1] = -(t[0] * result.m[0][1] + t[1] * result.m[1][1] + t[2] * result.m[2][1]);
+	result.m[3][2] = -(t[0] * result.m[0][2] + t[1] * result.m[1][2] + t[2] * result.m[2][2]);
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Matrix4x4 InverseRigid(const Matrix4x4& m) {
+	Matrix4x4 result;
+	// 回転部分は直交行列なので転置が逆行列になる
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			result.m[i][j] = m.m[j][i];
+		}
+		result.m[i][3] = 0.0f;
+	}
+
+	const float* t = m.m[3];
+	result.m[3][0] = -(t[0] * m.m[0][0] + t[1] * m.m[0][1] + t[2] * m.m[0][2]);
+	result.m[3][1] = -(t[0] * m.m[1][0] + t[1] * m.m[1][1] + t[2] * m.m[1][2]);
+	result.m[3][2] = -(t[0] * m.m[2][0] + t[1] * m.m[2][1] + t[2] * m.m[2][2]);
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Matrix4x4 InverseGeneral(const Matrix4x4& m) {
+	float determinant;
+	determinant =
+	    m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1] -
+	    m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2] - m.m[0][1] * m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[1][0] * m.m[2][3] * m.m[3][1] -
+	    m.m[0][3] * m.m[1][0] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[1][0] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[1][0] * m.m[2][3] * m.m[3][2] +
+	    m.m[0][1] * m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[2][0] * m.m[3][1] -
+	    m.m[0][2] * m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[0][2] * m.m[1][3] * m.m[2][1] * m.m[3][0] -
+	    m.m[0][3] * m.m[1][1] * m.m[2][2] * m.m[3][0] + m.m[0][3] * m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[0][2] * m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[0][1] * m.m[1][3] * m.m[2][2] * m.m[3][0];
+	// 16回割る代わりに逆数を1回だけ求めて掛ける
+	float inverseDeterminant = 1.0f / determinant;
+	Matrix4x4 result;
+	result = {
+	    (m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[1][2] * m.m[2][1] * m.m[3][3] -
+	     m.m[1][1] * m.m[2][3] * m.m[3][2]) *
+	        inverseDeterminant,
+	    (-m.m[0][1] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[2][1] * m.m[3][3] +
+	     m.m[0][1] * m.m[2][3] * m.m[3][2]) *
+	        inverseDeterminant,
+	    (m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[3][1] - m.m[0][2] * m.m[1][1] * m.m[3][3] -
+	     m.m[0][1] * m.m[1][3] * m.m[3][2]) *
+	        inverseDeterminant,
+	    (-m.m[0][1] * m.m[1][2] * m.m[2][3] - m.m[0][2] * m.m[1][3] * m.m[2][1] - m.m[0][3] * m.m[1][1] * m.m[2][2] + m.m[0][3] * m.m[1][2] * m.m[2][1] + m.m[0][2] * m.m[1][1] * m.m[2][3] +
+	     m.m[0][1] * m.m[1][3] * m.m[2][2]) *
+	        inverseDeterminant,
+	    (-m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[1][3] * m.m[2][0] * m.m[3][2] + m.m[1][3] * m.m[2][2] * m.m[3][0] + m.m[1][2] * m.m[2][0] * m.m[3][3] +
+	     m.m[1][0] * m.m[2][3] * m.m[3][2]) *
+	        inverseDeterminant,
+	    (m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0] + m.m[0][3] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[2][2] * m.m[3][0] - m.m[0][2] * m.m[2][0] * m.m[3][3] -
+	     m.m[0][0] * m.m[2][3] * m.m[3][2]) *
+	        inverseDeterminant,
+	    (-m.m[0][0] * m.m[1][2] * m.m[3][3] - m.m[0][2] * m.m[1][3] * m.m[3][0] - m.m[0][3] * m.m[1][0] * m.m[3][2] + m.m[0][3] * m.m[1][2] * m.m[3][0] + m.m[0][2] * m.m[1][0] * m.m[3][3] +
+	     m.m[0][0] * m.m[1][3] * m.m[3][2]) *
+	        inverseDeterminant,
+	    (m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] + m.m[0][3] * m.m[1][0] * m.m[2][2] - m.m[0][3] * m.m[1][2] * m.m[2][0] - m.m[0][2] * m.m[1][0] * m.m[2][3] -
+	     m.m[0][0] * m.m[1][3] * m.m[2][2]) *
+	        inverseDeterminant,
+	    (m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[1][3] * m.m[2][0] * m.m[3][1] - m.m[1][3] * m.m[2][1] * m.m[3][0] - m.m[1][1] * m.m[2][0] * m.m[3][3] -
+	     m.m[1][0] * m.m[2][3] * m.m[3][1]) *
+	        inverseDeterminant,
+	    (-m.m[0][0] * m.m[2][1] * m.m[3][3] - m.m[0][1] * m.m[2][3] * m.m[3][0] - m.m[0][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[2][1] * m.m[3][0] + m.m[0][1] * m.m[2][0] * m.m[3][3] +
+	     m.m[0][0] * m.m[2][3] * m.m[3][1]) *
+	        inverseDeterminant,
+	    (m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] + m.m[0][3] * m.m[1][0] * m.m[3][1] - m.m[0][3] * m.m[1][1] * m.m[3][0] - m.m[0][1] * m.m[1][0] * m.m[3][3] -
+	     m.m[0][0] * m.m[1][3] * m.m[3][1]) *
+	        inverseDeterminant,
+	    (-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] - m.m[0][3] * m.m[1][0] * m.m[2][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] + m.m[0][1] * m.m[1][0] * m.m[2][3] +
+	     m.m[0][0] * m.m[1][3] * m.m[2][1]) *
+	        inverseDeterminant,
+	    (-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1] + m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[1][1] * m.m[2][0] * m.m[3][2] +
+	     m.m[1][0] * m.m[2][2] * m.m[3][1]) *
+	        inverseDeterminant,
+	    (m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] + m.m[0][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[2][1] * m.m[3][0] - m.m[0][1] * m.m[2][0] * m.m[3][2] -
+	     m.m[0][0] * m.m[2][2] * m.m[3][1]) *
+	        inverseDeterminant,
+	    (-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0] - m.m[0][2] * m.m[1][0] * m.m[3][1] + m.m[0][2] * m.m[1][1] * m.m[3][0] + m.m[0][1] * m.m[1][0] * m.m[3][2] +
+	     m.m[0][0] * m.m[1][2] * m.m[3][1]) *
+	        inverseDeterminant,
+	    (m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] + m.m[0][2] * m.m[1][0] * m.m[2][1] - m.m[0][2] * m.m[1][1] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][2] -
+	     m.m[0][0] * m.m[1][2] * m.m[2][1]) *
+	        inverseDeterminant};
+	return result;
+}
+
+//=== スカラー実装 ===//
+namespace MathScalar {
+
+Vector3 Add(const Vector3& v1, const Vector3& v2) {
+	Vector3 result;
+	result.x = v1.x + v2.x;
+	result.y = v1.y + v2.y;
+	result.z = v1.z + v2.z;
+	return result;
+}
+
+Vector3 Subtract(const Vector3& v1, const Vector3& v2) {
+	Vector3 result;
+	result.x = v1.x - v2.x;
+	result.y = v1.y - v2.y;
+	result.z = v1.z - v2.z;
+	return result;
+}
+
+Vector3 Multiply(float s, const Vector3& v) {
+	Vector3 result = {v.x * s, v.y * s, v.z * s};
+	return result;
+}
+
+Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix) {
+	Vector3 result;
+	result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
+	result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
+	result.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2];
+	float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
+	assert(w != 0.0f);
+	result.x /= w;
+	result.y /= w;
+	result.z /= w;
+	return result;
+}
+
+void TransformPoints(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool perspectiveDivide) {
+	for (size_t i = 0; i < count; ++i) {
+		Vector3 v = in[i];
+		float x = v.x * matrix.m[0][0] + v.y * matrix.m[1][0] + v.z * matrix.m[2][0] + matrix.m[3][0];
+		float y = v.x * matrix.m[0][1] + v.y * matrix.m[1][1] + v.z * matrix.m[2][1] + matrix.m[3][1];
+		float z = v.x * matrix.m[0][2] + v.y * matrix.m[1][2] + v.z * matrix.m[2][2] + matrix.m[3][2];
+		if (perspectiveDivide) {
+			float w = v.x * matrix.m[0][3] + v.y * matrix.m[1][3] + v.z * matrix.m[2][3] + matrix.m[3][3];
+			float inv = 1.0f / w;
+			x *= inv;
+			y *= inv;
+			z *= inv;
+		}
+		out[i] = {x, y, z};
+	}
+}
+
+size_t TransformPointsPerspective(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool* visible) {
+	size_t visibleCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		Vector3 v = in[i];
+		float x = v.x * matrix.m[0][0] + v.y * matrix.m[1][0] + v.z * matrix.m[2][0] + matrix.m[3][0];
+		float y = v.x * matrix.m[0][1] + v.y * matrix.m[1][1] + v.z * matrix.m[2][1] + matrix.m[3][1];
+		float z = v.x * matrix.m[0][2] + v.y * matrix.m[1][2] + v.z * matrix.m[2][2] + matrix.m[3][2];
+		float w = v.x * matrix.m[0][3] + v.y * matrix.m[1][3] + v.z * matrix.m[2][3] + matrix.m[3][3];
+		visible[i] = w > 0.0f;
+		if (visible[i]) {
+			float inv = 1.0f / w;
+			out[i] = {x * inv, y * inv, z * inv};
+			++visibleCount;
+		} else {
+			out[i] = {x, y, z};
+		}
+	}
+	return visibleCount;
+}
+
+Matrix4x4 MatrixAdd(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][j] + m2.m[i][j];
+		}
+	}
+	return result;
+}
+
+Matrix4x4 MatrixSubtract(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][j] - m2.m[i][j];
+		}
+	}
+	return result;
+}
+
+Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result;
+	result.m[0][0] = m1.m[0][0] * m2.m[0][0] + m1.m[0][1] * m2.m[1][0] + m1.m[0][2] * m2.m[2][0] + m1.m[0][3] * m2.m[3][0];
+	result.m[0][1] = m1.m[0][0] * m2.m[0][1] + m1.m[0][1] * m2.m[1][1] + m1.m[0][2] * m2.m[2][1] + m1.m[0][3] * m2.m[3][1];
+	result.m[0][2] = m1.m[0][0] * m2.m[0][2] + m1.m[0][1] * m2.m[1][2] + m1.m[0][2] * m2.m[2][2] + m1.m[0][3] * m2.m[3][2];
+	result.m[0][3] = m1.m[0][0] * m2.m[0][3] + m1.m[0][1] * m2.m[1][3] + m1.m[0][2] * m2.m[2][3] + m1.m[0][3] * m2.m[3][3];
+	result.m[1][0] = m1.m[1][0] * m2.m[0][0] + m1.m[1][1] * m2.m[1][0] + m1.m[1][2] * m2.m[2][0] + m1.m[1][3] * m2.m[3][0];
+	result.m[1][1] = m1.m[1][0] * m2.m[0][1] + m1.m[1][1] * m2.m[1][1] + m1.m[1][2] * m2.m[2][1] + m1.m[1][3] * m2.m[3][1];
+	result.m[1][2] = m1.m[1][0] * m2.m[0][2] + m1.m[1][1] * m2.m[1][2] + m1.m[1][2] * m2.m[2][2] + m1.m[1][3] * m2.m[3][2];
+	result.m[1][3] = m1.m[1][0] * m2.m[0][3] + m1.m[1][1] * m2.m[1][3] + m1.m[1][2] * m2.m[2][3] + m1.m[1][3] * m2.m[3][3];
+	result.m[2][0] = m1.m[2][0] * m2.m[0][0] + m1.m[2][1] * m2.m[1][0] + m1.m[2][2] * m2.m[2][0] + m1.m[2][3] * m2.m[3][0];
+	result.m[2][1] = m1.m[2][0] * m2.m[0][1] + m1.m[2][1] * m2.m[1][1] + m1.m[2][2] * m2.m[2][1] + m1.m[2][3] * m2.m[3][1];
+	result.m[2][2] = m1.m[2][0] * m2.m[0][2] + m1.m[2][1] * m2.m[1][2] + m1.m[2][2] * m2.m[2][2] + m1.m[2][3] * m2.m[3][2];
+	result.m[2][3] = m1.m[2][0] * m2.m[0][3] + m1.m[2][1] * m2.m[1][3] + m1.m[2][2] * m2.m[2][3] + m1.m[2][3] * m2.m[3][3];
+	result.m[3][0] = m1.m[3][0] * m2.m[0][0] + m1.m[3][1] * m2.m[1][0] + m1.m[3][2] * m2.m[2][0] + m1.m[3][3] * m2.m[3][0];
+	result.m[3][1] = m1.m[3][0] * m2.m[0][1] + m1.m[3][1] * m2.m[1][1] + m1.m[3][2] * m2.m[2][1] + m1.m[3][3] * m2.m[3][1];
+	result.m[3][2] = m1.m[3][0] * m2.m[0][2] + m1.m[3][1] * m2.m[1][2] + m1.m[3][2] * m2.m[2][2] + m1.m[3][3] * m2.m[3][2];
+	result.m[3][3] = m1.m[3][0] * m2.m[0][3] + m1.m[3][1] * m2.m[1][3] + m1.m[3][2] * m2.m[2][3] + m1.m[3][3] * m2.m[3][3];
+	return result;
+}
+
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate) {
+	//====================
+	// 拡縮の行列の作成
+	//====================
+	Matrix4x4 scaleMatrix4x4;
+	scaleMatrix4x4.m[0][0] = scale.x;
+	scaleMatrix4x4.m[0][1] = 0.0f;
+	scaleMatrix4x4.m[0][2] = 0.0f;
+	scaleMatrix4x4.m[0][3] = 0.0f;
+
+	scaleMatrix4x4.m[1][0] = 0.0f;
+	scaleMatrix4x4.m[1][1] = scale.y;
+	scaleMatrix4x4.m[1][2] = 0.0f;
+	scaleMatrix4x4.m[1][3] = 0.0f;
+
+	scaleMatrix4x4.m[2][0] = 0.0f;
+	scaleMatrix4x4.m[2][1] = 0.0f;
+	scaleMatrix4x4.m[2][2] = scale.z;
+	scaleMatrix4x4.m[2][3] = 0.0f;
+
+	scaleMatrix4x4.m[3][0] = 0.0f;
+	scaleMatrix4x4.m[3][1] = 0.0f;
+	scaleMatrix4x4.m[3][2] = 0.0f;
+	scaleMatrix4x4.m[3][3] = 1.0f;
+
+	//===================
+	// 回転の行列の作成
+	//===================
+	// Xの回転行列
+	Matrix4x4 rotateMatrixX;
+	rotateMatrixX.m[0][0] = 1.0f;
+	rotateMatrixX.m[0][1] = 0.0f;
+	rotateMatrixX.m[0][2] = 0.0f;
+	rotateMatrixX.m[0][3] = 0.0f;
+
+	rotateMatrixX.m[1][0] = 0.0f;
+	rotateMatrixX.m[1][1] = cosf(rotate.x);
+	rotateMatrixX.m[1][2] = sinf(rotate.x);
+	rotateMatrixX.m[1][3] = 0.0f;
+
+	rotateMatrixX.m[2][0] = 0.0f;
+	rotateMatrixX.m[2][1] = -sinf(rotate.x);
+	rotateMatrixX.m[2][2] = cosf(rotate.x);
+	rotateMatrixX.m[2][3] = 0.0f;
+
+	rotateMatrixX.m[3][0] = 0.0f;
+	rotateMatrixX.m[3][1] = 0.0f;
+	rotateMatrixX.m[3][2] = 0.0f;
+	rotateMatrixX.m[3][3] = 1.0f;
+
+	// Yの回転行列
+	Matrix4x4 rotateMatrixY;
+	rotateMatrixY.m[0][0] = cosf(rotate.y);
+	rotateMatrixY.m[0][1] = 0.0f;
+	rotateMatrixY.m[0][2] = -sinf(rotate.y);
+	rotateMatrixY.m[0][3] = 0.0f;
+
+	rotateMatrixY.m[1][0] = 0.0f;
+	rotateMatrixY.m[1][1] = 1.0f;
+	rotateMatrixY.m[1][2] = 0.0f;
+	rotateMatrixY.m[1][3] = 0.0f;
+
+	rotateMatrixY.m[2][0] = sinf(rotate.y);
+	rotateMatrixY.m[2][1] = 0.0f;
+	rotateMatrixY.m[2][2] = cosf(rotate.y);
+	rotateMatrixY.m[2][3] = 0.0f;
+
+	rotateMatrixY.m[3][0] = 0.0f;
+	rotateMatrixY.m[3][1] = 0.0f;
+	rotateMatrixY.m[3][2] = 0.0f;
+	rotateMatrixY.m[3][3] = 1.0f;
+
+	// Zの回転行列
+	Matrix4x4 rotateMatrixZ;
+	rotateMatrixZ.m[0][0] = cosf(rotate.z);
+	rotateMatrixZ.m[0][1] = sinf(rotate.z);
+	rotateMatrixZ.m[0][2] = 0.0f;
+	rotateMatrixZ.m[0][3] = 0.0f;
+
+	rotateMatrixZ.m[1][0] = -sinf(rotate.z);
+	rotateMatrixZ.m[1][1] = cosf(rotate.z);
+	rotateMatrixZ.m[1][2] = 0.0f;
+	rotateMatrixZ.m[1][3] = 0.0f;
+
+	rotateMatrixZ.m[2][0] = 0.0f;
+	rotateMatrixZ.m[2][1] = 0.0f;
+	rotateMatrixZ.m[2][2] = 1.0f;
+	rotateMatrixZ.m[2][3] = 0.0f;
+
+	rotateMatrixZ.m[3][0] = 0.0f;
+	rotateMatrixZ.m[3][1] = 0.0f;
+	rotateMatrixZ.m[3][2] = 0.0f;
+	rotateMatrixZ.m[3][3] = 1.0f;
+
+	// 回転行列の作成
+	Matrix4x4 rotateMatrix4x4;
+
+	rotateMatrix4x4 = MathScalar::MatrixMultiply(rotateMatrixX, MathScalar::MatrixMultiply(rotateMatrixY, rotateMatrixZ));
+
+	//==================
+	// 移動の行列の作成
+	//==================
+	Matrix4x4 translateMatrix4x4;
+	translateMatrix4x4.m[0][0] = 1.0f;
+	translateMatrix4x4.m[0][1] = 0.0f;
+	translateMatrix4x4.m[0][2] = 0.0f;
+	translateMatrix4x4.m[0][3] = 0.0f;
+
+	translateMatrix4x4.m[1][0] = 0.0f;
+	translateMatrix4x4.m[1][1] = 1.0f;
+	translateMatrix4x4.m[1][2] = 0.0f;
+	translateMatrix4x4.m[1][3] = 0.0f;
+
+	translateMatrix4x4.m[2][0] = 0.0f;
+	translateMatrix4x4.m[2][1] = 0.0f;
+	translateMatrix4x4.m[2][2] = 1.0f;
+	translateMatrix4x4.m[2][3] = 0.0f;
+
+	translateMatrix4x4.m[3][0] = translate.x;
+	translateMatrix4x4.m[3][1] = translate.y;
+	translateMatrix4x4.m[3][2] = translate.z;
+	translateMatrix4x4.m[3][3] = 1.0f;
+
+	//====================
+	// アフィン行列の作成
+	//====================
+	// 上で作った行列からアフィン行列を作る
+	// アフィン行列の作成（スケール→回転→移動の順）
+	Matrix4x4 affineMatrix4x4;
+	affineMatrix4x4 = MathScalar::MatrixMultiply(scaleMatrix4x4, MathScalar::MatrixMultiply(rotateMatrix4x4, translateMatrix4x4));
+
+	return affineMatrix4x4;
+}
+
+} // namespace MathScalar
+
+//=== SIMD実装 ===//
+#if defined(MATH_SIMD_SSE)
+
+using MathSimd::LoadSoA4;
+using MathSimd::MulAdd;
+using MathSimd::StoreAoS4;
+
+Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix) {
+	// 行ベクトル × 行列 = 各行をベクトルの成分で重み付けした和
+	__m128 result = _mm_load_ps(matrix.m[3]);
+	result = MulAdd(_mm_set1_ps(vector.z), _mm_load_ps(matrix.m[2]), result);
+	result = MulAdd(_mm_set1_ps(vector.y), _mm_load_ps(matrix.m[1]), result);
+	result = MulAdd(_mm_set1_ps(vector.x), _mm_load_ps(matrix.m[0]), result);
+
+	__m128 w = _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 3, 3, 3));
+	assert(_mm_cvtss_f32(w) != 0.0f);
+	result = _mm_div_ps(result, w);
+
+	alignas(16) float out[4];
+	_mm_store_ps(out, result);
+	return {out[0], out[1], out[2]};
+}
+
+void TransformPoints(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool perspectiveDivide) {
+	size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+	// 行列の各要素を8レーンに複製しておく
+	__m256 m8[4][4];
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) {
+			m8[row][col] = _mm256_set1_ps(matrix.m[row][col]);
+		}
+	}
+	for (; i + 8 <= count; i += 8) {
+		__m128 x0, y0, z0, x1, y1, z1;
+		LoadSoA4(in + i, x0, y0, z0);
+		LoadSoA4(in + i + 4, x1, y1, z1);
+		__m256 x = _mm256_set_m128(x1, x0);
+		__m256 y = _mm256_set_m128(y1, y0);
+		__m256 z = _mm256_set_m128(z1, z0);
+
+		__m256 rx = MulAdd(x, m8[0][0], MulAdd(y, m8[1][0], MulAdd(z, m8[2][0], m8[3][0])));
+		__m256 ry = MulAdd(x, m8[0][1], MulAdd(y, m8[1][1], MulAdd(z, m8[2][1], m8[3][1])));
+		__m256 rz = MulAdd(x, m8[0][2], MulAdd(y, m8[1][2], MulAdd(z, m8[2][2], m8[3][2])));
+		if (perspectiveDivide) {
+			__m256 rw = MulAdd(x, m8[0][3], MulAdd(y, m8[1][3], MulAdd(z, m8[2][3], m8[3][3])));
+			__m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), rw);
+			rx = _mm256_mul_ps(rx, inv);
+			ry = _mm256_mul_ps(ry, inv);
+			rz = _mm256_mul_ps(rz, inv);
+		}
+
+		StoreAoS4(out + i, _mm256_castps256_ps128(rx), _mm256_castps256_ps128(ry), _mm256_castps256_ps128(rz));
+		StoreAoS4(out + i + 4, _mm256_extractf128_ps(rx, 1), _mm256_extractf128_ps(ry, 1), _mm256_extractf128_ps(rz, 1));
+	}
+#endif
+	__m128 m4[4][4];
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) {
+			m4[row][col] = _mm_set1_ps(matrix.m[row][col]);
+		}
+	}
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		LoadSoA4(in + i, x, y, z);
+
+		__m128 rx = MulAdd(x, m4[0][0], MulAdd(y, m4[1][0], MulAdd(z, m4[2][0], m4[3][0])));
+		__m128 ry = MulAdd(x, m4[0][1], MulAdd(y, m4[1][1], MulAdd(z, m4[2][1], m4[3][1])));
+		__m128 rz = MulAdd(x, m4[0][2], MulAdd(y, m4[1][2], MulAdd(z, m4[2][2], m4[3][2])));
+		if (perspectiveDivide) {
+			__m128 rw = MulAdd(x, m4[0][3], MulAdd(y, m4[1][3], MulAdd(z, m4[2][3], m4[3][3])));
+			__m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), rw);
+			rx = _mm_mul_ps(rx, inv);
+			ry = _mm_mul_ps(ry, inv);
+			rz = _mm_mul_ps(rz, inv);
+		}
+
+		StoreAoS4(out + i, rx, ry, rz);
+	}
+	// 4点に満たない残り
+	MathScalar::TransformPoints(in + i, count - i, matrix, out + i, perspectiveDivide);
+}
+
+size_t TransformPointsPerspective(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool* visible) {
+	__m128 m4[4][4];
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) {
+			m4[row][col] = _mm_set1_ps(matrix.m[row][col]);
+		}
+	}
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	size_t visibleCount = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		LoadSoA4(in + i, x, y, z);
+
+		__m128 rx = MulAdd(x, m4[0][0], MulAdd(y, m4[1][0], MulAdd(z, m4[2][0], m4[3][0])));
+		__m128 ry = MulAdd(x, m4[0][1], MulAdd(y, m4[1][1], MulAdd(z, m4[2][1], m4[3][1])));
+		__m128 rz = MulAdd(x, m4[0][2], MulAdd(y, m4[1][2], MulAdd(z, m4[2][2], m4[3][2])));
+		__m128 rw = MulAdd(x, m4[0][3], MulAdd(y, m4[1][3], MulAdd(z, m4[2][3], m4[3][3])));
+
+		// w > 0 のレーンだけ 1/w、それ以外は 1 を掛ける（0除算を起こさない）
+		__m128 inFront = _mm_cmpgt_ps(rw, zero);
+		__m128 inv = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(inFront, rw), _mm_andnot_ps(inFront, one)));
+		StoreAoS4(out + i, _mm_mul_ps(rx, inv), _mm_mul_ps(ry, inv), _mm_mul_ps(rz, inv));
+
+		int mask = _mm_movemask_ps(inFront);
+		for (int lane = 0; lane < 4; ++lane) {
+			visible[i + lane] = (mask >> lane) & 1;
+			visibleCount += static_cast<size_t>((mask >> lane) & 1);
+		}
+	}
+	// 4点に満たない残り
+	visibleCount += MathScalar::TransformPointsPerspective(in + i, count - i, matrix, out + i, visible + i);
+	return visibleCount;
+}
+
+#else
+
+Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix) { return MathScalar::Transform(vector, matrix); }
+
+void TransformPoints(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool perspectiveDivide) {
+	MathScalar::TransformPoints(in, count, matrix, out, perspectiveDivide);
+}
+
+size_t TransformPointsPerspective(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool* visible) {
+	return MathScalar::TransformPointsPerspective(in, count, matrix, out, visible);
+}
+
+#endif
+
+// 行列どうしの演算はどのバックエンドでもスカラー実装を使う。
+// 16要素を一度に読むだけなのでコンパイラがスカラー実装を同じ命令列へベクトル化し、
+// 手書きの SSE / AVX2 は MathBenchmark で 0.94〜1.06倍と速くならなかった
+Matrix4x4 MatrixAdd(const Matrix4x4& m1, const Matrix4x4& m2) { return MathScalar::MatrixAdd(m1, m2); }
+
+Matrix4x4 MatrixSubtract(const Matrix4x4& m1, const Matrix4x4& m2) { return MathScalar::MatrixSubtract(m1, m2); }
+
+Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2) { return MathScalar::MatrixMultiply(m1, m2); }
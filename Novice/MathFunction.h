@@ -0,0 +1,430 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+//=== SIMDバックエンドの選択（ビルド時） ===//
+// MATH_SIMD_AVX2 / MATH_SIMD_SSE / MATH_SIMD_SCALAR のどれかを定義して強制できる。
+// 未定義ならコンパイラの命令セット指定（/arch:AVX2, -mavx2 など）から自動で選ぶ。
+#if !defined(MATH_SIMD_AVX2) && !defined(MATH_SIMD_SSE) && !defined(MATH_SIMD_SCALAR)
+#if defined(__AVX2__)
+#define MATH_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SIMD_SSE
+#else
+#define MATH_SIMD_SCALAR
+#endif
+#endif
+
+// AVX2はSSEの上に成り立つのでSSEの経路も有効にする
+#if defined(MATH_SIMD_AVX2) && !defined(MATH_SIMD_SSE)
+#define MATH_SIMD_SSE
+#endif
+
+struct Vector3 {
+	float x; // X座標
+	float y; // Y座標
+	float z; // Z座標
+	constexpr Vector3& operator*=(float s) noexcept {
+		x *= s;
+		y *= s;
+		z *= s;
+		return *this;
+	}
+	constexpr Vector3& operator-=(const Vector3& v) noexcept {
+		x -= v.x;
+		y -= v.y;
+		z -= v.z;
+		return *this;
+	}
+	constexpr Vector3& operator+=(const Vector3& v) noexcept {
+		x += v.x;
+		y += v.y;
+		z += v.z;
+		return *this;
+	}
+	constexpr Vector3& operator/=(float s) noexcept {
+		x /= s;
+		y /= s;
+		z /= s;
+		return *this;
+	}
+};
+
+// 行列の種類。逆行列を求めるときに安い計算方法を選ぶための目印
+enum class MatrixKind {
+	General, // 一般の4x4行列（射影行列など）
+	Affine,  // 最後の列が (0,0,0,1) の行列（拡縮・回転・移動）
+	Rigid,   // 拡縮なしの回転と移動だけの行列
+};
+
+// 各行を16バイト境界に揃えて、1行をそのままSIMDレジスタに読み込めるようにする
+struct alignas(16) Matrix4x4 {
+	float m[4][4]; // 4x4行列
+};
+
+/// <summary>
+/// 使用中のSIMDバックエンド名
+/// </summary>
+/// <returns>"AVX2" / "SSE" / "Scalar"</returns>
+const char* GetMathBackendName();
+
+//=== Vector3の演算 ===//
+// 12バイトのVector3は1要素ずつ計算してもSIMDと差が出ないので、
+// 関数呼び出しのコストをなくすためにヘッダーでインライン展開する。
+// constexpr なので、定数の表などはコンパイル時に計算できる。
+
+/// <summary>
+/// 加算
+/// </summary>
+/// <param name="v1">加算するベクトル１</param>
+/// <param name="v2">加算するベクトル２</param>
+/// <returns>加算合計ベクトル</returns>
+constexpr Vector3 Add(const Vector3& v1, const Vector3& v2) noexcept { return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z}; }
+
+/// <summary>
+/// 減算
+/// </summary>
+/// <param name="v1">減算するベクトル１</param>
+/// <param name="v2">減算するベクトル２</param>
+/// <returns>減算合計ベクトル</returns>
+constexpr Vector3 Subtract(const Vector3& v1, const Vector3& v2) noexcept { return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z}; }
+
+/// <summary>
+/// スカラー倍
+/// </summary>
+/// <param name="s">スカラー</param>
+/// <param name="v">ベクトル</param>
+/// <returns>スカラー倍したベクトル</returns>
+constexpr Vector3 Multiply(float s, const Vector3& v) noexcept { return {v.x * s, v.y * s, v.z * s}; }
+
+/// <summary>
+/// 長さ（ノルム）
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <returns>長さ</returns>
+float Length(const Vector3& v);
+
+/// <summary>
+/// 内積
+/// </summary>
+/// <param name="v1">計算されるベクトル１</param>
+/// <param name="v2">計算されるベクトル２</param>
+/// <returns>合計値</returns>
+constexpr float Dot(const Vector3& v1, const Vector3& v2) noexcept { return (v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z); }
+
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) noexcept { return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x}; }
+
+Vector3 Perpendicular(const Vector3& vector);
+
+Vector3 Normalize(const Vector3& v);
+
+Vector3 Lerp(const Vector3& v1, const Vector3& v2, float t);
+
+Vector3 Bezier(const Vector3& p0, const Vector3& p1, const Vector3& p2, float t);
+
+//=== 行列の作成 ===//
+
+/// <summary>
+/// 透視投影行列
+/// </summary>
+/// <param name="fovY">画角Y</param>
+/// <param name="aspectRatio">アスペクト比</param>
+/// <param name="nearClip">近平面への距離</param>
+/// <param name="farClip">遠平面への距離</param>
+/// <returns>切り取る範囲</returns>
+Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip);
+
+/// <summary>
+/// ビューポート変換行列
+/// </summary>
+/// <param name="left">左座標</param>
+/// <param name="top">上座標</param>
+/// <param name="width">幅</param>
+/// <param name="height">高さ</param>
+/// <param name="minDepth">最小深度値</param>
+/// <param name="maxDepth">最大深度値</param>
+/// <returns>スクリーン座標系</returns>
+Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
+
+Matrix4x4 MakeRotateXMatrix(float radian);
+
+Matrix4x4 MakeRotateYMatrix(float radian);
+
+Matrix4x4 MakeRotateZMatrix(float radian);
+
+/// <summary>
+/// 3次元アフィン変換行列
+/// </summary>
+/// <param name="scale">拡縮</param>
+/// <param name="rotate">回転</param>
+/// <param name="translate">移動</param>
+/// <returns>変換結果</returns>
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate);
+
+//=== アフィン行列の閉じた形での作成 ===//
+// 拡縮・回転・移動の行列を5つ作って4回掛ける代わりに、
+// 各軸の sin/cos を1回ずつ求めて意味のある12要素を直接書き込む。
+namespace MathDetail {
+
+// rotate の3軸の sin と cos（精度は既定の精度段階に従う。FastMath.cpp で定義）
+void SinCos3(const Vector3& rotate, Vector3& s, Vector3& c);
+
+// S × Rx × Ry × Rz × T をまとめて計算する。使わない成分はコンパイル時に消える
+template<bool kScale, bool kRotate> inline Matrix4x4 ComposeAffine(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	Matrix4x4 result = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, translate.x, translate.y, translate.z, 1.0f};
+	if constexpr (kRotate) {
+		Vector3 s, c;
+		SinCos3(rotate, s, c);
+
+		result.m[0][0] = c.y * c.z;
+		result.m[0][1] = c.y * s.z;
+		result.m[0][2] = -s.y;
+		result.m[1][0] = s.x * s.y * c.z - c.x * s.z;
+		result.m[1][1] = s.x * s.y * s.z + c.x * c.z;
+		result.m[1][2] = s.x * c.y;
+		result.m[2][0] = c.x * s.y * c.z + s.x * s.z;
+		result.m[2][1] = c.x * s.y * s.z - s.x * c.z;
+		result.m[2][2] = c.x * c.y;
+	}
+	if constexpr (kScale) {
+		for (int i = 0; i < 3; ++i) {
+			float s = (&scale.x)[i];
+			result.m[i][0] *= s;
+			result.m[i][1] *= s;
+			result.m[i][2] *= s;
+		}
+	}
+	return result;
+}
+
+} // namespace MathDetail
+
+/// <summary>
+/// 平行移動行列（コンパイル時にも計算できる）
+/// </summary>
+/// <param name="translate">移動</param>
+/// <returns>変換結果</returns>
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	return {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, translate.x, translate.y, translate.z, 1.0f};
+}
+
+/// <summary>
+/// 回転と移動だけのアフィン行列（拡縮なし）
+/// </summary>
+/// <param name="rotate">回転</param>
+/// <param name="translate">移動</param>
+/// <returns>変換結果</returns>
+inline Matrix4x4 MakeRotateTranslateMatrix(const Vector3& rotate, const Vector3& translate) { return MathDetail::ComposeAffine<false, true>({1.0f, 1.0f, 1.0f}, rotate, translate); }
+
+/// <summary>
+/// 一様拡縮・回転・移動のアフィン行列
+/// </summary>
+/// <param name="scale">全軸共通の拡縮</param>
+/// <param name="rotate">回転</param>
+/// <param name="translate">移動</param>
+/// <returns>変換結果</returns>
+inline Matrix4x4 MakeUniformScaleAffineMatrix(float scale, const Vector3& rotate, const Vector3& translate) {
+	return MathDetail::ComposeAffine<true, true>({scale, scale, scale}, rotate, translate);
+}
+
+/// <summary>
+/// 3次元アフィン変換行列（行列の種類も返す）
+/// </summary>
+/// <param name="scale">拡縮</param>
+/// <param name="rotate">回転</param>
+/// <param name="translate">移動</param>
+/// <param name="kind">行列の種類の書き込み先。拡縮が (1,1,1) なら Rigid、それ以外は Affine</param>
+/// <returns>変換結果</returns>
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate, MatrixKind& kind);
+
+//=== 行列の演算 ===//
+
+/// <summary>
+/// 変換行列
+/// </summary>
+/// <param name="vector">次元</param>
+/// <param name="matrix">行列</param>
+/// <returns>変換後行列</returns>
+Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
+
+/// <summary>
+/// 点列をまとめて変換する（SIMDで4点または8点ずつ処理）
+/// </summary>
+/// <param name="in">変換する点の配列</param>
+/// <param name="count">点の数</param>
+/// <param name="matrix">行列</param>
+/// <param name="out">変換後の点の書き込み先（in と同じでもよい）</param>
+/// <param name="perspectiveDivide">w で割るかどうか（アフィン行列なら false で省略できる）</param>
+void TransformPoints(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool perspectiveDivide = true);
+
+/// <summary>
+/// 透視投影付きで点列をまとめて変換する。w が0以下（カメラの後ろ）の点は割らずに見えない扱いにする
+/// </summary>
+/// <param name="in">変換する点の配列</param>
+/// <param name="count">点の数</param>
+/// <param name="matrix">行列</param>
+/// <param name="out">変換後の点の書き込み先（in と同じでもよい）</param>
+/// <param name="visible">各点が見えるか（w が正か）の書き込み先</param>
+/// <returns>見えた点の数</returns>
+size_t TransformPointsPerspective(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool* visible);
+
+/// <summary>
+/// 逆行列（最後の列が (0,0,0,1) ならアフィン用の計算に自動で切り替える）
+/// </summary>
+/// <param name="m">変換される行列</param>
+/// <returns>変換結果</returns>
+Matrix4x4 Inverse(const Matrix4x4& m);
+
+/// <summary>
+/// 逆行列（行列の種類を指定して計算方法を選ぶ）
+/// </summary>
+/// <param name="m">変換される行列</param>
+/// <param name="kind">行列の種類</param>
+/// <returns>変換結果</returns>
+Matrix4x4 Inverse(const Matrix4x4& m, MatrixKind kind);
+
+/// <summary>
+/// 一般の4x4逆行列（余因子展開）
+/// </summary>
+/// <param name="m">変換される行列</param>
+/// <returns>変換結果</returns>
+Matrix4x4 InverseGeneral(const Matrix4x4& m);
+
+/// <summary>
+/// アフィン行列の逆行列。左上3x3の逆行列と移動成分だけを計算する
+/// </summary>
+/// <param name="m">最後の列が (0,0,0,1) の行列</param>
+/// <returns>変換結果</returns>
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+/// <summary>
+/// 回転と移動だけの行列の逆行列。回転部分は転置、移動は転置した回転で戻す
+/// </summary>
+/// <param name="m">拡縮を含まないアフィン行列</param>
+/// <returns>変換結果</returns>
+Matrix4x4 InverseRigid(const Matrix4x4& m);
+
+/// <summary>
+/// 行列の和
+/// </summary>
+/// <param name="m1">計算される行列1</param>
+/// <param name="m2">計算される行列2</param>
+/// <returns>計算結果</returns>
+Matrix4x4 MatrixAdd(const Matrix4x4& m1, const Matrix4x4& m2);
+
+/// <summary>
+/// 行列の差
+/// </summary>
+/// <param name="m1">計算される行列1</param>
+/// <param name="m2">計算される行列2</param>
+/// <returns>計算結果</returns>
+Matrix4x4 MatrixSubtract(const Matrix4x4& m1, const Matrix4x4& m2);
+
+/// <summary>
+/// 行列の積
+/// </summary>
+/// <param name="m1">計算される行列1</param>
+/// <param name="m2">計算される行列2</param>
+/// <returns>計算結果</returns>
+Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2);
+
+//=== スカラー実装 ===//
+// SIMDバックエンドの比較用。どのバックエンドでも常にビルドされる。
+namespace MathScalar {
+
+Vector3 Add(const Vector3& v1, const Vector3& v2);
+
+Vector3 Subtract(const Vector3& v1, const Vector3& v2);
+
+Vector3 Multiply(float s, const Vector3& v);
+
+Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
+
+void TransformPoints(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool perspectiveDivide = true);
+
+size_t TransformPointsPerspective(const Vector3* in, size_t count, const Matrix4x4& matrix, Vector3* out, bool* visible);
+
+Matrix4x4 MatrixAdd(const Matrix4x4& m1, const Matrix4x4& m2);
+
+Matrix4x4 MatrixSubtract(const Matrix4x4& m1, const Matrix4x4& m2);
+
+Matrix4x4 MatrixMultiply(const Matrix4x4& m1, const Matrix4x4& m2);
+
+// 拡縮・回転・移動の行列を個別に作って掛け合わせる従来の作り方
+Matrix4x4 MakeAffineMatrix(Vector3 scale, Vector3 rotate, Vector3 translate);
+
+} // namespace MathScalar
+
+/*------------------２項演算子----------------------*/
+#if defined(MATH_EXPRESSION_TEMPLATES)
+// Vector3 の演算子は式テンプレートで定義する（MathExpression.h）
+#include "MathExpression.h"
+#else
+constexpr Vector3 operator+(Vector3 v1, Vector3 v2) noexcept { return Add(v1, v2); }
+
+constexpr Vector3 operator-(Vector3 v1, Vector3 v2) noexcept { return Subtract(v1, v2); }
+
+constexpr Vector3 operator*(float s, Vector3 v) noexcept { return Multiply(s, v); }
+
+constexpr Vector3 operator*(Vector3 v, float s) noexcept {
+	return Multiply(s, v); // 逆順でも使えるように同じ実装
+}
+
+constexpr Vector3 operator/(Vector3 v, float s) noexcept {
+	float inv = 1.0f / s;
+	return Multiply(inv, v);
+}
+#endif
+
+// 行列の演算子はコンパイル時には1要素ずつ計算し、実行時は MatrixAdd などを呼ぶ
+constexpr Matrix4x4 operator+(const Matrix4x4& m1, const Matrix4x4& m2) noexcept {
+	if (std::is_constant_evaluated()) {
+		Matrix4x4 result{};
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				result.m[row][column] = m1.m[row][column] + m2.m[row][column];
+			}
+		}
+		return result;
+	}
+	return MatrixAdd(m1, m2);
+}
+
+constexpr Matrix4x4 operator-(const Matrix4x4& m1, const Matrix4x4& m2) noexcept {
+	if (std::is_constant_evaluated()) {
+		Matrix4x4 result{};
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				result.m[row][column] = m1.m[row][column] - m2.m[row][column];
+			}
+		}
+		return result;
+	}
+	return MatrixSubtract(m1, m2);
+}
+
+constexpr Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) noexcept {
+	if (std::is_constant_evaluated()) {
+		Matrix4x4 result{};
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				for (int k = 0; k < 4; ++k) {
+					result.m[row][column] += m1.m[row][k] * m2.m[k][column];
+				}
+			}
+		}
+		return result;
+	}
+	return MatrixMultiply(m1, m2);
+}
+/*-------------------------------------------------------*/
+
+/*-------------------------単項演算子-------------------------------*/
+#if !defined(MATH_EXPRESSION_TEMPLATES)
+constexpr Vector3 operator-(Vector3 v) noexcept { return {-v.x, -v.y, -v.z}; }
+
+constexpr Vector3 operator+(Vector3 v) noexcept { return v; }
+#endif
+/*----------------------------------------------------------------*/
@@ -0,0 +1,47 @@
+#pragma once
+#include "MathFunction.h"
+
+// SIMD実装で共有する内部ヘルパー（MathFunction.cpp などの実装ファイルからのみインクルードする）
+#if defined(MATH_SIMD_SSE)
+#include <immintrin.h>
+
+namespace MathSimd {
+
+// a * b + c（FMAが使えるならまとめて1命令）
+inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+	return _mm_fmadd_ps(a, b, c);
+#else
+	return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+#if defined(MATH_SIMD_AVX2)
+inline __m256 MulAdd(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+#endif
+
+// Vector3 4個分（float 12個）を読み込み、x / y / z ごとのレジスタに並べ替える
+inline void LoadSoA4(const Vector3* p, __m128& x, __m128& y, __m128& z) {
+	const float* f = reinterpret_cast<const float*>(p);
+	__m128 a = _mm_loadu_ps(f);     // x0 y0 z0 x1
+	__m128 b = _mm_loadu_ps(f + 4); // y1 z1 x2 y2
+	__m128 c = _mm_loadu_ps(f + 8); // z2 x3 y3 z3
+	x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+	y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+// x / y / z のレジスタを Vector3 4個分の並びに戻して書き込む
+inline void StoreAoS4(Vector3* p, __m128 x, __m128 y, __m128 z) {
+	float* f = reinterpret_cast<float*>(p);
+	__m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	__m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+	__m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	_mm_storeu_ps(f, a);
+	_mm_storeu_ps(f + 4, b);
+	_mm_storeu_ps(f + 8, c);
+}
+
+} // namespace MathSimd
+
+#endif
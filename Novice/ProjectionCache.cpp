@@ -0,0 +1,93 @@
+#include "ProjectionCache.h"
+#include <algorithm>
+#include <assert.h>
+
+uint32_t ProjectionCache::AddShape(const Vector3* points, size_t count) {
+	uint32_t shape = static_cast<uint32_t>(offsets_.size());
+	offsets_.push_back(static_cast<uint32_t>(points_.size()));
+	counts_.push_back(static_cast<uint32_t>(count));
+	cameraVersions_.push_back(0);
+	visible_.push_back(0);
+	points_.insert(points_.end(), points, points + count);
+	clip_.resize(points_.size());
+	return shape;
+}
+
+void ProjectionCache::SetPoints(uint32_t shape, const Vector3* points) {
+	std::copy(points, points + counts_[shape], points_.begin() + offsets_[shape]);
+	cameraVersions_[shape] = 0;
+}
+
+const ClipVertex* ProjectionCache::Project(uint32_t shape, const ScreenProjector& projector) {
+	uint32_t version = projector.GetCameraVersion();
+	uint32_t count = counts_[shape];
+	if (version != 0 && cameraVersions_[shape] == version) {
+		reusedCount_ += count;
+	} else {
+		// 視錐台の外なら変換はしない（判定の結果だけ覚えておく）
+		const Vector3* points = points_.data() + offsets_[shape];
+		bool visible = IsVisible(projector.GetFrustum(), points, count);
+		if (visible) {
+			projector.TransformPoints(points, count, clip_.data() + offsets_[shape]);
+			transformedCount_ += count;
+		}
+		visible_[shape] = visible ? 1 : 0;
+		cameraVersions_[shape] = version;
+	}
+	return visible_[shape] ? clip_.data() + offsets_[shape] : nullptr;
+}
+
+void ProjectionCache::ProjectShapes(uint32_t first, uint32_t count, const ScreenProjector& projector, const bool* visible) {
+	uint32_t version = projector.GetCameraVersion();
+
+	// 図形の頂点は番号の順に続けて並んでいるので、並んだ図形はまとめて変換できる
+	uint32_t runBegin = 0;
+	uint32_t runEnd = 0;
+	auto flushRun = [&]() {
+		if (runEnd > runBegin) {
+			uint32_t begin = offsets_[runBegin];
+			uint32_t end = offsets_[runEnd - 1] + counts_[runEnd - 1];
+			projector.TransformPoints(points_.data() + begin, end - begin, clip_.data() + begin);
+			transformedCount_ += end - begin;
+		}
+		runBegin = runEnd = 0;
+	};
+
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t shape = first + i;
+		if (!visible[i]) {
+			flushRun();
+			continue;
+		}
+		if (version != 0 && cameraVersions_[shape] == version && visible_[shape]) {
+			reusedCount_ += counts_[shape];
+			flushRun();
+			continue;
+		}
+		if (runEnd != shape) {
+			flushRun();
+			runBegin = shape;
+		}
+		runEnd = shape + 1;
+		cameraVersions_[shape] = version;
+		visible_[shape] = 1;
+	}
+	flushRun();
+}
+
+void ProjectionCache::RemoveShape(uint32_t shape) {
+	uint32_t last = GetShapeCount() - 1;
+	assert(counts_[shape] == counts_[last]);
+	if (shape != last) {
+		std::copy_n(points_.begin() + offsets_[last], counts_[last], points_.begin() + offsets_[shape]);
+		std::copy_n(clip_.begin() + offsets_[last], counts_[last], clip_.begin() + offsets_[shape]);
+		cameraVersions_[shape] = cameraVersions_[last];
+		visible_[shape] = visible_[last];
+	}
+	points_.resize(offsets_[last]);
+	clip_.resize(offsets_[last]);
+	offsets_.pop_back();
+	counts_.pop_back();
+	cameraVersions_.pop_back();
+	visible_.pop_back();
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "ScreenProjector.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 動かない図形の頂点を覚えておき、変換した結果（ClipVertex）と視錐台の判定を使い回す。
+/// カメラの番号（CameraVersionCounter）か図形の頂点が変わったときだけ変換し直すので、カメラが止まっている間は変換しない。
+/// 番号のないプロジェクター（WithWorld で作ったものなど）では毎回変換する。
+/// 中身を書き換えるので、1つの ProjectionCache を複数のスレッドから同時に使わないこと
+/// </summary>
+class ProjectionCache {
+public:
+	/// <summary>
+	/// 図形を追加する
+	/// </summary>
+	/// <param name="points">ワールド座標の頂点</param>
+	/// <param name="count">頂点の数</param>
+	/// <returns>追加した図形の番号</returns>
+	uint32_t AddShape(const Vector3* points, size_t count);
+
+	/// <summary>
+	/// 図形の頂点を置き換える（次の Project で変換し直す）
+	/// </summary>
+	/// <param name="shape">図形の番号</param>
+	/// <param name="points">ワールド座標の頂点（AddShape と同じ数）</param>
+	void SetPoints(uint32_t shape, const Vector3* points);
+
+	/// <summary>
+	/// 図形の頂点を変換する。前回と同じカメラの番号なら、前回の結果をそのまま返す
+	/// </summary>
+	/// <param name="shape">図形の番号</param>
+	/// <param name="projector">スクリーン座標への変換</param>
+	/// <returns>変換した頂点（AddShape の順）。視錐台の外なら nullptr。
+	/// 指す先は次の AddShape で無効になり（頂点の配列が伸びるため）、次の Project や SetPoints の後は中身が変わりうる。
+	/// 使うのは次にこのキャッシュを触るまでにすること</returns>
+	const ClipVertex* Project(uint32_t shape, const ScreenProjector& projector);
+
+	/// <summary>
+	/// 番号が first から count 個の図形のうち、visible[i] が true の図形の頂点を変換する（視錐台の判定は呼び出し側で済ませておく）。
+	/// 前回と同じカメラの番号なら変換せず、変換し直す図形が並んでいる間はまとめて1回で変換する。結果は GetClip で読む
+	/// </summary>
+	/// <param name="first">先頭の図形の番号</param>
+	/// <param name="count">図形の数</param>
+	/// <param name="projector">スクリーン座標への変換</param>
+	/// <param name="visible">図形ごとの判定（count 個）</param>
+	void ProjectShapes(uint32_t first, uint32_t count, const ScreenProjector& projector, const bool* visible);
+
+	/// <summary>
+	/// 図形を消す。最後の図形を shape の番号へ移して詰める（消す図形と最後の図形は同じ頂点数であること）
+	/// </summary>
+	/// <param name="shape">図形の番号</param>
+	void RemoveShape(uint32_t shape);
+
+	const Vector3* GetPoints(uint32_t shape) const { return points_.data() + offsets_[shape]; }
+	// ProjectShapes で変換した頂点（指す先の扱いは Project の戻り値と同じ）
+	const ClipVertex* GetClip(uint32_t shape) const { return clip_.data() + offsets_[shape]; }
+	uint32_t GetPointCount(uint32_t shape) const { return counts_[shape]; }
+	uint32_t GetShapeCount() const { return static_cast<uint32_t>(offsets_.size()); }
+
+	// ResetStats から Project で変換した頂点の数と、使い回した頂点の数
+	size_t GetTransformedCount() const { return transformedCount_; }
+	size_t GetReusedCount() const { return reusedCount_; }
+	void ResetStats() { transformedCount_ = reusedCount_ = 0; }
+
+private:
+	// 図形ごとの値（SoA）
+	std::vector<uint32_t> offsets_;        // points_ と clip_ の中の先頭
+	std::vector<uint32_t> counts_;         // 頂点の数
+	std::vector<uint32_t> cameraVersions_; // clip_ を求めたときのカメラの番号（0 なら求め直す）
+	std::vector<uint8_t> visible_;         // そのときの視錐台の判定
+
+	// 全図形の頂点を続けて並べたもの
+	std::vector<Vector3> points_;
+	std::vector<ClipVertex> clip_;
+
+	size_t transformedCount_ = 0;
+	size_t reusedCount_ = 0;
+};
@@ -0,0 +1,136 @@
+#include "Quaternion.h"
+#include "FastMath.h"
+#include "MathSimd.h"
+#include <cmath>
+
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle) {
+	float s, c;
+	FastMath::SinCos(angle * 0.5f, s, c);
+	return {axis.x * s, axis.y * s, axis.z * s, c};
+}
+
+Quaternion MakeRotateQuaternion(const Vector3& rotate) {
+	float sx, cx, sy, cy, sz, cz;
+	FastMath::SinCos(rotate.x * 0.5f, sx, cx);
+	FastMath::SinCos(rotate.y * 0.5f, sy, cy);
+	FastMath::SinCos(rotate.z * 0.5f, sz, cz);
+
+	// X → Y → Z の順に回転する合成を展開したもの
+	return {
+	    sx * cy * cz - cx * sy * sz,
+	    cx * sy * cz + sx * cy * sz,
+	    cx * cy * sz - sx * sy * cz,
+	    cx * cy * cz + sx * sy * sz,
+	};
+}
+
+Quaternion Normalize(const Quaternion& q) {
+	float inverseLength = 1.0f / std::sqrt(Dot(q, q));
+	return {q.x * inverseLength, q.y * inverseLength, q.z * inverseLength, q.w * inverseLength};
+}
+
+Matrix4x4 MakeRotateMatrix(const Quaternion& q) { return MakeQuaternionRotateTranslateMatrix(q, {0.0f, 0.0f, 0.0f}); }
+
+Matrix4x4 MakeQuaternionRotateTranslateMatrix(const Quaternion& rotate, const Vector3& translate) {
+	float xx = rotate.x * rotate.x;
+	float yy = rotate.y * rotate.y;
+	float zz = rotate.z * rotate.z;
+	float xy = rotate.x * rotate.y;
+	float xz = rotate.x * rotate.z;
+	float yz = rotate.y * rotate.z;
+	float wx = rotate.w * rotate.x;
+	float wy = rotate.w * rotate.y;
+	float wz = rotate.w * rotate.z;
+
+	return {
+	    1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz),        2.0f * (xz - wy),        0.0f,
+	    2.0f * (xy - wz),        1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx),        0.0f,
+	    2.0f * (xz + wy),        2.0f * (yz - wx),        1.0f - 2.0f * (xx + yy), 0.0f,
+	    translate.x,             translate.y,             translate.z,             1.0f,
+	};
+}
+
+Matrix4x4 MakeQuaternionAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+	Matrix4x4 result = MakeQuaternionRotateTranslateMatrix(rotate, translate);
+	for (int i = 0; i < 3; ++i) {
+		float s = (&scale.x)[i];
+		result.m[i][0] *= s;
+		result.m[i][1] *= s;
+		result.m[i][2] *= s;
+	}
+	return result;
+}
+
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	// q と -q は同じ回転なので、近い方へ補間する
+	float sign = Dot(q0, q1) < 0.0f ? -1.0f : 1.0f;
+	float t0 = 1.0f - t;
+	float t1 = t * sign;
+	return Normalize({q0.x * t0 + q1.x * t1, q0.y * t0 + q1.y * t1, q0.z * t0 + q1.z * t1, q0.w * t0 + q1.w * t1});
+}
+
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	float dot = Dot(q0, q1);
+	float sign = 1.0f;
+	if (dot < 0.0f) {
+		dot = -dot;
+		sign = -1.0f;
+	}
+	// ほぼ同じ向きのときは sin(θ) が0に近く割れないので Nlerp で代用する
+	if (dot > 0.9995f) {
+		return Nlerp(q0, q1, t);
+	}
+	float theta = std::acos(dot);
+	float inverseSin = 1.0f / std::sin(theta);
+	float t0 = std::sin((1.0f - t) * theta) * inverseSin;
+	float t1 = std::sin(t * theta) * inverseSin * sign;
+	return {q0.x * t0 + q1.x * t1, q0.y * t0 + q1.y * t1, q0.z * t0 + q1.z * t1, q0.w * t0 + q1.w * t1};
+}
+
+#if defined(MATH_SIMD_SSE)
+
+void RotateVectors(const Vector3* in, size_t count, const Quaternion& q, Vector3* out) {
+	using MathSimd::LoadSoA4;
+	using MathSimd::MulAdd;
+	using MathSimd::StoreAoS4;
+
+	const __m128 ux = _mm_set1_ps(q.x);
+	const __m128 uy = _mm_set1_ps(q.y);
+	const __m128 uz = _mm_set1_ps(q.z);
+	const __m128 w = _mm_set1_ps(q.w);
+	const __m128 two = _mm_set1_ps(2.0f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 vx, vy, vz;
+		LoadSoA4(in + i, vx, vy, vz);
+
+		// t = 2 * u × v
+		__m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(uy, vz), _mm_mul_ps(uz, vy)));
+		__m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(uz, vx), _mm_mul_ps(ux, vz)));
+		__m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(ux, vy), _mm_mul_ps(uy, vx)));
+
+		// v + w * t + u × t
+		__m128 rx = MulAdd(w, tx, vx);
+		__m128 ry = MulAdd(w, ty, vy);
+		__m128 rz = MulAdd(w, tz, vz);
+		rx = _mm_add_ps(rx, _mm_sub_ps(_mm_mul_ps(uy, tz), _mm_mul_ps(uz, ty)));
+		ry = _mm_add_ps(ry, _mm_sub_ps(_mm_mul_ps(uz, tx), _mm_mul_ps(ux, tz)));
+		rz = _mm_add_ps(rz, _mm_sub_ps(_mm_mul_ps(ux, ty), _mm_mul_ps(uy, tx)));
+
+		StoreAoS4(out + i, rx, ry, rz);
+	}
+	for (; i < count; ++i) {
+		out[i] = RotateVector(in[i], q);
+	}
+}
+
+#else
+
+void RotateVectors(const Vector3* in, size_t count, const Quaternion& q, Vector3* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = RotateVector(in[i], q);
+	}
+}
+
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+#include "MathFunction.h"
+
+/// <summary>
+/// 回転を表すクォータニオン（x, y, z が虚部、w が実部）。
+/// 行列の16要素に対して4要素なので、大量の回転を持つ場合にメモリと合成の負荷が小さい
+/// </summary>
+struct Quaternion {
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+/// <summary>
+/// 回転なし
+/// </summary>
+/// <returns>単位クォータニオン</returns>
+constexpr Quaternion IdentityQuaternion() { return {0.0f, 0.0f, 0.0f, 1.0f}; }
+
+/// <summary>
+/// 任意軸回転
+/// </summary>
+/// <param name="axis">回転軸（正規化済み）</param>
+/// <param name="angle">角度（ラジアン）</param>
+/// <returns>クォータニオン</returns>
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle);
+
+/// <summary>
+/// オイラー角からの回転（MakeRotateXMatrix * MakeRotateYMatrix * MakeRotateZMatrix と同じ回転）
+/// </summary>
+/// <param name="rotate">各軸の回転角（ラジアン）</param>
+/// <returns>クォータニオン</returns>
+Quaternion MakeRotateQuaternion(const Vector3& rotate);
+
+/// <summary>
+/// 合成（行列と同じく、lhs の回転のあとに rhs の回転を行う）
+/// MakeRotateMatrix(Multiply(a, b)) は MakeRotateMatrix(a) * MakeRotateMatrix(b) と等しい
+/// </summary>
+/// <param name="lhs">先に行う回転</param>
+/// <param name="rhs">後に行う回転</param>
+/// <returns>合成した回転</returns>
+inline Quaternion Multiply(const Quaternion& lhs, const Quaternion& rhs) {
+	// ハミルトン積 rhs * lhs
+	return {
+	    rhs.w * lhs.x + rhs.x * lhs.w + rhs.y * lhs.z - rhs.z * lhs.y,
+	    rhs.w * lhs.y - rhs.x * lhs.z + rhs.y * lhs.w + rhs.z * lhs.x,
+	    rhs.w * lhs.z + rhs.x * lhs.y - rhs.y * lhs.x + rhs.z * lhs.w,
+	    rhs.w * lhs.w - rhs.x * lhs.x - rhs.y * lhs.y - rhs.z * lhs.z,
+	};
+}
+
+inline float Dot(const Quaternion& q1, const Quaternion& q2) { return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w; }
+
+/// <summary>
+/// 共役（単位クォータニオンなら逆回転）
+/// </summary>
+inline Quaternion Conjugate(const Quaternion& q) { return {-q.x, -q.y, -q.z, q.w}; }
+
+/// <summary>
+/// 正規化（合成を繰り返したあとの誤差の蓄積を戻す）
+/// </summary>
+Quaternion Normalize(const Quaternion& q);
+
+/// <summary>
+/// ベクトルを回転する
+/// </summary>
+/// <param name="vector">ベクトル</param>
+/// <param name="q">回転（単位クォータニオン）</param>
+/// <returns>回転後のベクトル</returns>
+inline Vector3 RotateVector(const Vector3& vector, const Quaternion& q) {
+	// v' = v + w * t + u × t（t = 2 * u × v）で、q * v * q^-1 を展開するより乗算が少ない
+	Vector3 u = {q.x, q.y, q.z};
+	Vector3 t = Cross(u, vector);
+	t = {t.x * 2.0f, t.y * 2.0f, t.z * 2.0f};
+	Vector3 ut = Cross(u, t);
+	return {vector.x + q.w * t.x + ut.x, vector.y + q.w * t.y + ut.y, vector.z + q.w * t.z + ut.z};
+}
+
+/// <summary>
+/// 複数のベクトルを同じ回転で回転する（SIMDで4個ずつ処理、in と out は同じ配列でもよい）
+/// </summary>
+/// <param name="in">ベクトルの配列</param>
+/// <param name="count">個数</param>
+/// <param name="q">回転（単位クォータニオン）</param>
+/// <param name="out">出力先</param>
+void RotateVectors(const Vector3* in, size_t count, const Quaternion& q, Vector3* out);
+
+/// <summary>
+/// 回転行列に変換する（各行が回転後の x / y / z 軸）
+/// </summary>
+/// <param name="q">回転（単位クォータニオン）</param>
+/// <returns>回転行列</returns>
+Matrix4x4 MakeRotateMatrix(const Quaternion& q);
+
+/// <summary>
+/// 回転と移動の行列（拡縮なし）
+/// </summary>
+/// <param name="rotate">回転（単位クォータニオン）</param>
+/// <param name="translate">移動</param>
+/// <returns>変換結果</returns>
+Matrix4x4 MakeQuaternionRotateTranslateMatrix(const Quaternion& rotate, const Vector3& translate);
+
+/// <summary>
+/// 拡縮・回転・移動のアフィン行列
+/// </summary>
+/// <param name="scale">拡縮</param>
+/// <param name="rotate">回転（単位クォータニオン）</param>
+/// <param name="translate">移動</param>
+/// <returns>変換結果</returns>
+Matrix4x4 MakeQuaternionAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
+/// <summary>
+/// 正規化線形補間（速いが角速度は一定にならない）
+/// </summary>
+/// <param name="q0">t = 0 の回転</param>
+/// <param name="q1">t = 1 の回転</param>
+/// <param name="t">補間係数</param>
+/// <returns>補間した回転</returns>
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+/// <summary>
+/// 球面線形補間（角速度一定）
+/// </summary>
+/// <param name="q0">t = 0 の回転</param>
+/// <param name="q1">t = 1 の回転</param>
+/// <param name="t">補間係数</param>
+/// <returns>補間した回転</returns>
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+inline Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs) { return Multiply(lhs, rhs); }
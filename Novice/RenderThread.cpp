@@ -0,0 +1,61 @@
+#include "RenderThread.h"
+#include <assert.h>
+
+RenderThread::RenderThread(LineFlushFunction submitFunction) : submitFunction_(submitFunction), thread_(&RenderThread::ThreadLoop, this) {}
+
+RenderThread::~RenderThread() { Stop(); }
+
+void RenderThread::Submit(LineBatch& batch) {
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		assert(!stop_);
+		doneCondition_.wait(lock, [this] { return !pending_; });
+		pendingBatch_.Swap(batch);
+		pending_ = true;
+	}
+	wakeCondition_.notify_one();
+}
+
+void RenderThread::Wait() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	doneCondition_.wait(lock, [this] { return !pending_; });
+}
+
+void RenderThread::Stop() {
+	if (!thread_.joinable()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	wakeCondition_.notify_one();
+	thread_.join();
+}
+
+uint64_t RenderThread::GetSubmittedCount() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return submittedCount_;
+}
+
+void RenderThread::ThreadLoop() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;) {
+		// 止めるときも、渡された線は送ってから抜ける
+		wakeCondition_.wait(lock, [this] { return pending_ || stop_; });
+		if (!pending_) {
+			return;
+		}
+
+		lock.unlock();
+		if (submitFunction_ && pendingBatch_.GetCount() > 0) {
+			submitFunction_(pendingBatch_.GetLines(), pendingBatch_.GetCount());
+		}
+		pendingBatch_.Clear();
+		lock.lock();
+
+		pending_ = false;
+		++submittedCount_;
+		doneCondition_.notify_all();
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "LineBatch.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// 1フレーム分の線を描画スレッドへ渡し、送り先の関数へ送らせる。
+/// 線のリストは2つを入れ替えて使う（ダブルバッファ）。呼び出し側が次のフレームの線をためている間、
+/// 描画スレッドはもう一方のリストだけを読むので、2つのスレッドが同じリストを同時に触ることはない。
+/// 送り先の関数は描画スレッドで呼ばれる。Novice はスレッドセーフではないので Novice::DrawLine は渡さず、
+/// 描画スレッドだけが触る Framebuffer に描く LineRasterizer のような、ほかのスレッドと何も共有しない先に使う
+/// </summary>
+class RenderThread {
+public:
+	/// <summary>
+	/// コンストラクタ（描画スレッドを立ち上げる）
+	/// </summary>
+	/// <param name="submitFunction">描画スレッドで線を送る先</param>
+	explicit RenderThread(LineFlushFunction submitFunction);
+
+	// Stop する
+	~RenderThread();
+
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+
+	/// <summary>
+	/// 前に渡した線を送り終えるのを待ってから、batch の線を描画スレッドへ渡す（送り終えるのは待たない）。
+	/// フレームの線を全部ためてから呼ぶ。batch は送り終えたほうのリストと入れ替わり、空で戻る
+	/// </summary>
+	/// <param name="batch">1フレーム分の線をためたもの</param>
+	void Submit(LineBatch& batch);
+
+	/// <summary>
+	/// 渡した線を送り終えるまで待つ
+	/// </summary>
+	void Wait();
+
+	/// <summary>
+	/// 渡した線を送り終えてからスレッドを止める（2回目からは何もしない）。
+	/// 送り先が使うもの（Framebuffer など）を片付ける前に呼ぶ。止めたあとは Submit しないこと
+	/// </summary>
+	void Stop();
+
+	// 送り終えたフレームの数
+	uint64_t GetSubmittedCount() const;
+
+private:
+	void ThreadLoop();
+
+	LineFlushFunction submitFunction_;
+	LineBatch pendingBatch_; // 描画スレッドが送るリスト（pending_ の間は描画スレッドだけが触る）
+
+	mutable std::mutex mutex_;
+	std::condition_variable wakeCondition_;
+	std::condition_variable doneCondition_;
+	bool pending_ = false;
+	bool stop_ = false;
+	uint64_t submittedCount_ = 0;
+
+	std::thread thread_; // 上のメンバーを使うので最後に作る
+};
@@ -0,0 +1,319 @@
+#include "ScreenProjector.h"
+#include "MathSimd.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace {
+
+// 最後に配ったカメラの番号（すべての CameraVersionCounter で共有する）
+std::atomic<uint32_t> lastCameraVersion{0};
+
+} // namespace
+
+ScreenProjector::ScreenProjector() : worldToScreenMatrix_{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}, frustum_(MakeFrustum(worldToScreenMatrix_)) {}
+
+ScreenProjector::ScreenProjector(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix, const Matrix4x4& viewportMatrix) {
+	// ビューポート行列はアフィンなので、w で割る前に掛けても結果は同じになる
+	Matrix4x4 viewProjectionMatrix = MatrixMultiply(viewMatrix, projectionMatrix);
+	worldToScreenMatrix_ = MatrixMultiply(viewProjectionMatrix, viewportMatrix);
+	frustum_ = MakeFrustum(viewProjectionMatrix);
+	pixelScale_ = std::fabs(projectionMatrix.m[1][1] * viewportMatrix.m[1][1]);
+
+	// ビューポート行列から画面の範囲を戻す（縦は上下が反転している）
+	const Matrix4x4& v = viewportMatrix;
+	viewportLeft_ = v.m[3][0] - std::fabs(v.m[0][0]);
+	viewportRight_ = v.m[3][0] + std::fabs(v.m[0][0]);
+	viewportTop_ = v.m[3][1] - std::fabs(v.m[1][1]);
+	viewportBottom_ = v.m[3][1] + std::fabs(v.m[1][1]);
+	guardLeft_ = viewportLeft_ - kGuardBandMargin;
+	guardRight_ = viewportRight_ + kGuardBandMargin;
+	guardTop_ = viewportTop_ - kGuardBandMargin;
+	guardBottom_ = viewportBottom_ + kGuardBandMargin;
+	minDepth_ = v.m[3][2];
+}
+
+ScreenProjector ScreenProjector::WithWorld(const Matrix4x4& worldMatrix) const {
+	// 視錐台と拡大率はそのまま引き継ぐ
+	ScreenProjector result = *this;
+	result.worldToScreenMatrix_ = MatrixMultiply(worldMatrix, worldToScreenMatrix_);
+	result.cameraVersion_ = 0;
+	return result;
+}
+
+uint32_t CameraVersionCounter::Stamp(ScreenProjector& projector) {
+	// 画面の範囲もビューポート行列から求めているので、合成済みの行列が同じなら変換はすべて同じ
+	if (version_ == 0 || std::memcmp(&worldToScreenMatrix_, &projector.worldToScreenMatrix_, sizeof(Matrix4x4)) != 0) {
+		worldToScreenMatrix_ = projector.worldToScreenMatrix_;
+		do {
+			version_ = ++lastCameraVersion;
+		} while (version_ == 0);
+	}
+	projector.cameraVersion_ = version_;
+	return version_;
+}
+
+bool ScreenProjector::Project(const Vector3& point, Vector3& screen) const {
+	const Matrix4x4& m = worldToScreenMatrix_;
+	float w = point.x * m.m[0][3] + point.y * m.m[1][3] + point.z * m.m[2][3] + m.m[3][3];
+	if (w <= 0.0f) {
+		return false;
+	}
+	float inv = 1.0f / w;
+	screen = {
+	    (point.x * m.m[0][0] + point.y * m.m[1][0] + point.z * m.m[2][0] + m.m[3][0]) * inv,
+	    (point.x * m.m[0][1] + point.y * m.m[1][1] + point.z * m.m[2][1] + m.m[3][1]) * inv,
+	    (point.x * m.m[0][2] + point.y * m.m[1][2] + point.z * m.m[2][2] + m.m[3][2]) * inv,
+	};
+	return true;
+}
+
+float ScreenProjector::GetProjectedRadius(const Vector3& center, float radius) const {
+	// ビューポート行列は w を変えないので、w はビュー空間の奥行きになる
+	const Matrix4x4& m = worldToScreenMatrix_;
+	float w = center.x * m.m[0][3] + center.y * m.m[1][3] + center.z * m.m[2][3] + m.m[3][3];
+	if (w <= radius) {
+		return std::numeric_limits<float>::infinity();
+	}
+	// 視線上にある球の接線から求めた見かけの半径
+	return radius * pixelScale_ / std::sqrt(w * w - radius * radius);
+}
+
+size_t ScreenProjector::ProjectPoints(const Vector3* points, size_t count, Vector3* screen, bool* visible) const {
+	return TransformPointsPerspective(points, count, worldToScreenMatrix_, screen, visible);
+}
+
+ClipVertex ScreenProjector::MakeClipVertex(float x, float y, float z, float w) const {
+	uint32_t code = 0;
+	code |= (x < viewportLeft_ * w) ? kOutsideLeft : 0u;
+	code |= (x > viewportRight_ * w) ? kOutsideRight : 0u;
+	code |= (y < viewportTop_ * w) ? kOutsideTop : 0u;
+	code |= (y > viewportBottom_ * w) ? kOutsideBottom : 0u;
+	code |= (x < guardLeft_ * w) ? kOutsideLeft << kGuardShift : 0u;
+	code |= (x > guardRight_ * w) ? kOutsideRight << kGuardShift : 0u;
+	code |= (y < guardTop_ * w) ? kOutsideTop << kGuardShift : 0u;
+	code |= (y > guardBottom_ * w) ? kOutsideBottom << kGuardShift : 0u;
+	if (z < minDepth_ * w || w <= 0.0f) {
+		code |= kOutsideNear | (kOutsideNear << kGuardShift);
+	}
+	float inv = (w > 0.0f) ? 1.0f / w : 1.0f;
+	return {x, y, z, w, {x * inv, y * inv, z * inv}, code};
+}
+
+#if defined(MATH_SIMD_SSE)
+
+void ScreenProjector::TransformPoints(const Vector3* points, size_t count, ClipVertex* clip) const {
+	static_assert(sizeof(ClipVertex) == 32, "4点ずつ転置して書き込む");
+	using MathSimd::MulAdd;
+	const Matrix4x4& matrix = worldToScreenMatrix_;
+	__m128 m4[4][4];
+	for (int row = 0; row < 4; ++row) {
+		for (int col = 0; col < 4; ++col) {
+			m4[row][col] = _mm_set1_ps(matrix.m[row][col]);
+		}
+	}
+	// 外側判定に使う境界と、そのときに立てるビット
+	const __m128 bounds[8] = {
+	    _mm_set1_ps(viewportLeft_), _mm_set1_ps(viewportRight_), _mm_set1_ps(viewportTop_), _mm_set1_ps(viewportBottom_),
+	    _mm_set1_ps(guardLeft_),    _mm_set1_ps(guardRight_),    _mm_set1_ps(guardTop_),    _mm_set1_ps(guardBottom_),
+	};
+	const __m128 minDepth = _mm_set1_ps(minDepth_);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	auto bit = [](uint32_t value) { return _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(value))); };
+	const __m128 leftBit = bit(kOutsideLeft);
+	const __m128 rightBit = bit(kOutsideRight);
+	const __m128 topBit = bit(kOutsideTop);
+	const __m128 bottomBit = bit(kOutsideBottom);
+	const __m128 guardLeftBit = bit(kOutsideLeft << kGuardShift);
+	const __m128 guardRightBit = bit(kOutsideRight << kGuardShift);
+	const __m128 guardTopBit = bit(kOutsideTop << kGuardShift);
+	const __m128 guardBottomBit = bit(kOutsideBottom << kGuardShift);
+	const __m128 nearBits = bit(kOutsideNear | (kOutsideNear << kGuardShift));
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		MathSimd::LoadSoA4(points + i, x, y, z);
+		__m128 rx = MulAdd(x, m4[0][0], MulAdd(y, m4[1][0], MulAdd(z, m4[2][0], m4[3][0])));
+		__m128 ry = MulAdd(x, m4[0][1], MulAdd(y, m4[1][1], MulAdd(z, m4[2][1], m4[3][1])));
+		__m128 rz = MulAdd(x, m4[0][2], MulAdd(y, m4[1][2], MulAdd(z, m4[2][2], m4[3][2])));
+		__m128 rw = MulAdd(x, m4[0][3], MulAdd(y, m4[1][3], MulAdd(z, m4[2][3], m4[3][3])));
+
+		__m128 code = _mm_and_ps(_mm_cmplt_ps(rx, _mm_mul_ps(bounds[0], rw)), leftBit);
+		code = _mm_or_ps(code, _mm_and_ps(_mm_cmpgt_ps(rx, _mm_mul_ps(bounds[1], rw)), rightBit));
+		code = _mm_or_ps(code, _mm_and_ps(_mm_cmplt_ps(ry, _mm_mul_ps(bounds[2], rw)), topBit));
+		code = _mm_or_ps(code, _mm_and_ps(_mm_cmpgt_ps(ry, _mm_mul_ps(bounds[3], rw)), bottomBit));
+		code = _mm_or_ps(code, _mm_and_ps(_mm_cmplt_ps(rx, _mm_mul_ps(bounds[4], rw)), guardLeftBit));
+		code = _mm_or_ps(code, _mm_and_ps(_mm_cmpgt_ps(rx, _mm_mul_ps(bounds[5], rw)), guardRightBit));
+		code = _mm_or_ps(code, _mm_and_ps(_mm_cmplt_ps(ry, _mm_mul_ps(bounds[6], rw)), guardTopBit));
+		code = _mm_or_ps(code, _mm_and_ps(_mm_cmpgt_ps(ry, _mm_mul_ps(bounds[7], rw)), guardBottomBit));
+		__m128 inFront = _mm_cmpgt_ps(rw, zero);
+		__m128 behindNear = _mm_or_ps(_mm_cmplt_ps(rz, _mm_mul_ps(minDepth, rw)), _mm_cmple_ps(rw, zero));
+		code = _mm_or_ps(code, _mm_and_ps(behindNear, nearBits));
+
+		// w > 0 のレーンだけ 1/w、それ以外は 1 を掛ける（0除算を起こさない）
+		__m128 inv = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(inFront, rw), _mm_andnot_ps(inFront, one)));
+		__m128 sx = _mm_mul_ps(rx, inv);
+		__m128 sy = _mm_mul_ps(ry, inv);
+		__m128 sz = _mm_mul_ps(rz, inv);
+
+		_MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+		_MM_TRANSPOSE4_PS(sx, sy, sz, code);
+		_mm_storeu_ps(&clip[i + 0].x, rx);
+		_mm_storeu_ps(&clip[i + 0].screen.x, sx);
+		_mm_storeu_ps(&clip[i + 1].x, ry);
+		_mm_storeu_ps(&clip[i + 1].screen.x, sy);
+		_mm_storeu_ps(&clip[i + 2].x, rz);
+		_mm_storeu_ps(&clip[i + 2].screen.x, sz);
+		_mm_storeu_ps(&clip[i + 3].x, rw);
+		_mm_storeu_ps(&clip[i + 3].screen.x, code);
+	}
+	for (; i < count; ++i) {
+		const Vector3& p = points[i];
+		clip[i] = MakeClipVertex(
+		    p.x * matrix.m[0][0] + p.y * matrix.m[1][0] + p.z * matrix.m[2][0] + matrix.m[3][0], p.x * matrix.m[0][1] + p.y * matrix.m[1][1] + p.z * matrix.m[2][1] + matrix.m[3][1],
+		    p.x * matrix.m[0][2] + p.y * matrix.m[1][2] + p.z * matrix.m[2][2] + matrix.m[3][2], p.x * matrix.m[0][3] + p.y * matrix.m[1][3] + p.z * matrix.m[2][3] + matrix.m[3][3]);
+	}
+}
+
+#else
+
+void ScreenProjector::TransformPoints(const Vector3* points, size_t count, ClipVertex* clip) const {
+	const Matrix4x4& matrix = worldToScreenMatrix_;
+	for (size_t i = 0; i < count; ++i) {
+		const Vector3& p = points[i];
+		clip[i] = MakeClipVertex(
+		    p.x * matrix.m[0][0] + p.y * matrix.m[1][0] + p.z * matrix.m[2][0] + matrix.m[3][0], p.x * matrix.m[0][1] + p.y * matrix.m[1][1] + p.z * matrix.m[2][1] + matrix.m[3][1],
+		    p.x * matrix.m[0][2] + p.y * matrix.m[1][2] + p.z * matrix.m[2][2] + matrix.m[3][2], p.x * matrix.m[0][3] + p.y * matrix.m[1][3] + p.z * matrix.m[2][3] + matrix.m[3][3]);
+	}
+}
+
+#endif
+
+bool ScreenProjector::ClipLineToGuardBand(const ClipVertex& a, const ClipVertex& b, Vector3& screenA, Vector3& screenB) const {
+	// ニアクリップ面とガードバンドの各辺で Liang–Barsky のクリッピングをする。
+	// 各面は f(P) >= 0 が内側の1次式なので、同次座標のまま f(a) / (f(a) - f(b)) で交点の t が求まる
+	const float distanceA[5] = {
+	    a.x - guardLeft_ * a.w, guardRight_ * a.w - a.x, a.y - guardTop_ * a.w, guardBottom_ * a.w - a.y, a.z - minDepth_ * a.w,
+	};
+	const float distanceB[5] = {
+	    b.x - guardLeft_ * b.w, guardRight_ * b.w - b.x, b.y - guardTop_ * b.w, guardBottom_ * b.w - b.y, b.z - minDepth_ * b.w,
+	};
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+	for (int plane = 0; plane < 5; ++plane) {
+		float da = distanceA[plane];
+		float db = distanceB[plane];
+		if (da < 0.0f && db < 0.0f) {
+			return false;
+		}
+		if (da < 0.0f) {
+			t0 = (std::max)(t0, da / (da - db));
+		} else if (db < 0.0f) {
+			t1 = (std::min)(t1, da / (da - db));
+		}
+	}
+	if (t0 > t1) {
+		return false;
+	}
+
+	// 切った点を w で割る（ニアクリップ面の内側なので w は正のはず。平行投影に近く正にならないときは描かない）
+	auto clipAt = [&a, &b](float t, Vector3& screen) {
+		float w = a.w + (b.w - a.w) * t;
+		if (w <= 0.0f) {
+			return false;
+		}
+		float inv = 1.0f / w;
+		screen = {(a.x + (b.x - a.x) * t) * inv, (a.y + (b.y - a.y) * t) * inv, (a.z + (b.z - a.z) * t) * inv};
+		return true;
+	};
+	if (t0 > 0.0f || (a.outcode & kOutsideNear)) {
+		if (!clipAt(t0, screenA)) {
+			return false;
+		}
+	} else {
+		screenA = a.screen;
+	}
+	if (t1 < 1.0f || (b.outcode & kOutsideNear)) {
+		return clipAt(t1, screenB);
+	}
+	screenB = b.screen;
+	return true;
+}
+
+size_t ScreenProjector::ClipTriangleToGuardBand(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, Vector3* polygon) const {
+	// Sutherland–Hodgman。頂点が外に出ている面だけで順に切る（1面切るごとに頂点は最大1つ増える）
+	struct Homogeneous {
+		float x, y, z, w;
+	};
+	Homogeneous buffers[2][kMaxClippedPolygonVertices];
+	Homogeneous* input = buffers[0];
+	Homogeneous* output = buffers[1];
+	input[0] = {a.x, a.y, a.z, a.w};
+	input[1] = {b.x, b.y, b.z, b.w};
+	input[2] = {c.x, c.y, c.z, c.w};
+	size_t count = 3;
+
+	// 面の内側で正になる1次式（ClipLineToGuardBand と同じ。並びは outcode のビット順）
+	auto distance = [this](int plane, const Homogeneous& p) {
+		switch (plane) {
+		case 0:
+			return p.x - guardLeft_ * p.w;
+		case 1:
+			return guardRight_ * p.w - p.x;
+		case 2:
+			return p.y - guardTop_ * p.w;
+		case 3:
+			return guardBottom_ * p.w - p.y;
+		default:
+			return p.z - minDepth_ * p.w;
+		}
+	};
+
+	const uint32_t outside = ((a.outcode | b.outcode | c.outcode) & kGuardOutcodeMask) >> kGuardShift;
+	for (int plane = 0; plane < 5; ++plane) {
+		if ((outside & (1u << plane)) == 0) {
+			continue;
+		}
+		size_t outputCount = 0;
+		for (size_t i = 0; i < count; ++i) {
+			const Homogeneous& p = input[i];
+			const Homogeneous& q = input[(i + 1) % count];
+			const float dp = distance(plane, p);
+			const float dq = distance(plane, q);
+			if (dp >= 0.0f) {
+				output[outputCount++] = p;
+			}
+			if ((dp >= 0.0f) != (dq >= 0.0f)) {
+				const float t = dp / (dp - dq);
+				output[outputCount++] = {p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t, p.z + (q.z - p.z) * t, p.w + (q.w - p.w) * t};
+			}
+		}
+		std::swap(input, output);
+		count = outputCount;
+		if (count < 3) {
+			return 0;
+		}
+	}
+
+	// w で割る（ニアクリップ面の内側なので w は正のはず。ClipLineToGuardBand と同じく正でなければ描かない）
+	for (size_t i = 0; i < count; ++i) {
+		if (input[i].w <= 0.0f) {
+			return 0;
+		}
+		const float inv = 1.0f / input[i].w;
+		polygon[i] = {input[i].x * inv, input[i].y * inv, input[i].z * inv};
+	}
+	return count;
+}
+
+bool ScreenProjector::ProjectLine(const Vector3& a, const Vector3& b, Vector3& screenA, Vector3& screenB) const {
+	const Vector3 points[2] = {a, b};
+	ClipVertex clip[2];
+	TransformPoints(points, 2, clip);
+	return ClipLine(clip[0], clip[1], screenA, screenB);
+}
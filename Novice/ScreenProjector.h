@@ -0,0 +1,204 @@
+#pragma once
+#include "Frustum.h"
+#include "MathFunction.h"
+#include <cstdint>
+
+// TransformPoints で変換した頂点。線のクリッピングに使う
+struct ClipVertex {
+	float x; // スクリーン空間の同次座標（w で割る前）
+	float y;
+	float z;
+	float w;
+	Vector3 screen;   // w で割ったスクリーン座標（outcode に kOutsideNear があるときは使えない）
+	uint32_t outcode; // 画面・ガードバンドの各辺とニアクリップ面の外側にあるかのビット
+};
+
+// ClipVertex::outcode のビット。下位5ビットが画面、kGuardShift だけずらした5ビットがガードバンド
+enum : uint32_t {
+	kOutsideLeft = 1 << 0,
+	kOutsideRight = 1 << 1,
+	kOutsideTop = 1 << 2,
+	kOutsideBottom = 1 << 3,
+	kOutsideNear = 1 << 4,
+	kGuardShift = 8,
+	kViewportOutcodeMask = 0x1F,
+	kGuardOutcodeMask = 0x1F << kGuardShift,
+};
+
+// 線をそのまま渡す範囲として、画面の外側に取る余白（ピクセル）。
+// この範囲に収まる線は切らずに渡し、はみ出す線だけを切り詰める
+const float kGuardBandMargin = 512.0f;
+
+// ClipTriangle で切ったあとの多角形の頂点数の上限（三角形の3頂点 + 切る面5枚で1つずつ）
+const size_t kMaxClippedPolygonVertices = 8;
+
+/// <summary>
+/// ワールド座標をスクリーン座標へ変換する。
+/// ビュー・射影・ビューポート行列を1つにまとめておき、1回の4x4変換と1回の逆数で画面上の位置を求める
+/// </summary>
+class ScreenProjector {
+public:
+	ScreenProjector();
+
+	/// <summary>
+	/// コンストラクタ（毎フレーム、カメラが決まったあとに作る）
+	/// </summary>
+	/// <param name="viewMatrix">ビュー行列</param>
+	/// <param name="projectionMatrix">射影行列</param>
+	/// <param name="viewportMatrix">ビューポート変換行列</param>
+	ScreenProjector(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix, const Matrix4x4& viewportMatrix);
+
+	/// <summary>
+	/// ローカル座標から直接変換するプロジェクターを作る（カメラの番号は0になる）
+	/// </summary>
+	/// <param name="worldMatrix">ワールド行列（アフィン）</param>
+	/// <returns>ワールド行列を合成したプロジェクター</returns>
+	ScreenProjector WithWorld(const Matrix4x4& worldMatrix) const;
+
+	// CameraVersionCounter が付けたカメラの番号。同じ番号のプロジェクターは同じ変換をする（0 は番号なし）
+	uint32_t GetCameraVersion() const { return cameraVersion_; }
+
+	/// <summary>
+	/// 1点を変換する
+	/// </summary>
+	/// <param name="point">ワールド座標</param>
+	/// <param name="screen">スクリーン座標の書き込み先</param>
+	/// <returns>カメラの前にあるか（w が正か）。false のとき screen は使えない</returns>
+	bool Project(const Vector3& point, Vector3& screen) const;
+
+	/// <summary>
+	/// 点列をまとめて変換する
+	/// </summary>
+	/// <param name="points">ワールド座標の配列</param>
+	/// <param name="count">点の数</param>
+	/// <param name="screen">スクリーン座標の書き込み先（points と同じでもよい）</param>
+	/// <param name="visible">各点がカメラの前にあるかの書き込み先</param>
+	/// <returns>カメラの前にあった点の数</returns>
+	size_t ProjectPoints(const Vector3* points, size_t count, Vector3* screen, bool* visible) const;
+
+	/// <summary>
+	/// 点列をまとめて変換し、同次座標・スクリーン座標・外側判定のビットを求める（線を ClipLine で切るとき用）
+	/// </summary>
+	/// <param name="points">ワールド座標の配列</param>
+	/// <param name="count">点の数</param>
+	/// <param name="clip">同次座標の書き込み先</param>
+	void TransformPoints(const Vector3* points, size_t count, ClipVertex* clip) const;
+
+	/// <summary>
+	/// 同次座標の線分を、ニアクリップ面とガードバンド（画面＋ kGuardBandMargin）で切ってスクリーン座標にする。
+	/// カメラの後ろをまたぐ線も正しく切り詰め、画面に全く映らない線は捨てる
+	/// </summary>
+	/// <param name="a">始点の同次座標</param>
+	/// <param name="b">終点の同次座標</param>
+	/// <param name="screenA">切ったあとの始点のスクリーン座標</param>
+	/// <param name="screenB">切ったあとの終点のスクリーン座標</param>
+	/// <returns>画面に映る部分が残ったか</returns>
+	bool ClipLine(const ClipVertex& a, const ClipVertex& b, Vector3& screenA, Vector3& screenB) const {
+		// 画面の同じ辺の外側に両端があれば映らない（Cohen–Sutherland の判定）
+		if (a.outcode & b.outcode & kViewportOutcodeMask) {
+			return false;
+		}
+		// 両端がガードバンドの中なら切らずに渡す
+		if (((a.outcode | b.outcode) & kGuardOutcodeMask) == 0) {
+			screenA = a.screen;
+			screenB = b.screen;
+			return true;
+		}
+		return ClipLineToGuardBand(a, b, screenA, screenB);
+	}
+
+	/// <summary>
+	/// ワールド座標の線分を変換して ClipLine で切る
+	/// </summary>
+	bool ProjectLine(const Vector3& a, const Vector3& b, Vector3& screenA, Vector3& screenB) const;
+
+	/// <summary>
+	/// 同次座標の三角形を、ニアクリップ面とガードバンドで切ってスクリーン座標の凸多角形にする（塗りつぶし用）
+	/// </summary>
+	/// <param name="a">頂点１の同次座標</param>
+	/// <param name="b">頂点２の同次座標</param>
+	/// <param name="c">頂点３の同次座標</param>
+	/// <param name="polygon">多角形の頂点の書き込み先（kMaxClippedPolygonVertices 個分）</param>
+	/// <returns>多角形の頂点数（画面に映らなければ0）</returns>
+	size_t ClipTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, Vector3* polygon) const {
+		if (a.outcode & b.outcode & c.outcode & kViewportOutcodeMask) {
+			return 0;
+		}
+		if (((a.outcode | b.outcode | c.outcode) & kGuardOutcodeMask) == 0) {
+			polygon[0] = a.screen;
+			polygon[1] = b.screen;
+			polygon[2] = c.screen;
+			return 3;
+		}
+		return ClipTriangleToGuardBand(a, b, c, polygon);
+	}
+
+	/// <summary>
+	/// 球が画面上で何ピクセルの半径に見えるか（LODの選択用の目安）
+	/// </summary>
+	/// <param name="center">ワールド座標の中心</param>
+	/// <param name="radius">半径</param>
+	/// <returns>画面上の半径（ピクセル）。カメラが球の中にあるか近すぎるときは無限大</returns>
+	float GetProjectedRadius(const Vector3& center, float radius) const;
+
+	// ワールド空間の視錐台（WithWorld で作ったプロジェクターでもワールド空間のまま）
+	const Frustum& GetFrustum() const { return frustum_; }
+
+	// ワールド→スクリーンの合成済み行列
+	const Matrix4x4& GetWorldToScreenMatrix() const { return worldToScreenMatrix_; }
+
+private:
+	friend class CameraVersionCounter;
+
+	// ClipLine の、ガードバンドやニアクリップ面で実際に切る部分
+	bool ClipLineToGuardBand(const ClipVertex& a, const ClipVertex& b, Vector3& screenA, Vector3& screenB) const;
+
+	// ClipTriangle の、ガードバンドやニアクリップ面で実際に切る部分
+	size_t ClipTriangleToGuardBand(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, Vector3* polygon) const;
+
+	// 同次座標から ClipVertex を完成させる
+	ClipVertex MakeClipVertex(float x, float y, float z, float w) const;
+
+	// ビュー × 射影 × ビューポート
+	Matrix4x4 worldToScreenMatrix_;
+	// カメラからの距離1で、ワールドの長さ1が何ピクセルになるか（射影とビューポートの縦の拡大率の積）
+	float pixelScale_ = 1.0f;
+	Frustum frustum_;
+	// 画面とガードバンドの範囲（ピクセル）と、ニアクリップ面にあたる深度
+	float viewportLeft_ = -1.0f;
+	float viewportTop_ = -1.0f;
+	float viewportRight_ = 1.0f;
+	float viewportBottom_ = 1.0f;
+	float guardLeft_ = -1.0f;
+	float guardTop_ = -1.0f;
+	float guardRight_ = 1.0f;
+	float guardBottom_ = 1.0f;
+	float minDepth_ = 0.0f;
+	uint32_t cameraVersion_ = 0;
+};
+
+/// <summary>
+/// カメラが動いたフレームだけ番号を進める。毎フレーム作った ScreenProjector を Stamp に渡して番号を付けると、
+/// ProjectionCache は番号が変わるまで前のフレームの変換結果を使い回す。
+/// 番号はすべてのカウンターで通しなので、別のカメラと同じ番号になることはない
+/// </summary>
+class CameraVersionCounter {
+public:
+	/// <summary>
+	/// 変換が前回の Stamp と違えば番号を進め、projector に今の番号を付ける
+	/// </summary>
+	/// <param name="projector">このフレームのプロジェクター</param>
+	/// <returns>付けた番号</returns>
+	uint32_t Stamp(ScreenProjector& projector);
+
+	/// <summary>
+	/// 次の Stamp で必ず番号を進める（ビューポートの大きさを変えたときなど）
+	/// </summary>
+	void Invalidate() { version_ = 0; }
+
+	uint32_t GetVersion() const { return version_; }
+
+private:
+	Matrix4x4 worldToScreenMatrix_ = {};
+	uint32_t version_ = 0;
+};
@@ -0,0 +1,101 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+// このスレッドが今仕事を処理しているスレッドプール（処理中でなければ nullptr）
+thread_local const ThreadPool* runningPool = nullptr;
+
+} // namespace
+
+ThreadPool::ThreadPool(uint32_t workerCount) {
+	if (workerCount == 0) {
+		uint32_t hardware = std::thread::hardware_concurrency();
+		workerCount = hardware > 1 ? hardware - 1 : 0;
+	}
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	wakeCondition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+}
+
+ThreadPool* ThreadPool::GetInstance() {
+	static ThreadPool instance;
+	return &instance;
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& func) {
+	grainSize = (std::max)(grainSize, size_t(1));
+	// 分ける意味がないときと、このプールの仕事の中から呼ばれたとき（dispatchMutex_ を待つと止まってしまう）はその場で実行する
+	if (workers_.empty() || count <= grainSize || runningPool == this) {
+		if (count > 0) {
+			func(0, count);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		job_ = &func;
+		jobCount_ = count;
+		jobGrain_ = grainSize;
+		nextIndex_.store(0);
+		busyWorkers_ = static_cast<uint32_t>(workers_.size());
+		++generation_;
+	}
+	wakeCondition_.notify_all();
+
+	RunChunks();
+
+	// ワーカー全員が手を離すまで待つ（func の寿命を守る）
+	std::unique_lock<std::mutex> lock(mutex_);
+	doneCondition_.wait(lock, [this] { return busyWorkers_ == 0; });
+	job_ = nullptr;
+}
+
+void ThreadPool::RunChunks() {
+	const ThreadPool* outerPool = runningPool;
+	runningPool = this;
+	for (;;) {
+		size_t begin = nextIndex_.fetch_add(jobGrain_);
+		if (begin >= jobCount_) {
+			break;
+		}
+		size_t end = (std::min)(begin + jobGrain_, jobCount_);
+		(*job_)(begin, end);
+	}
+	runningPool = outerPool;
+}
+
+void ThreadPool::WorkerLoop() {
+	uint64_t seenGeneration = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			wakeCondition_.wait(lock, [&] { return stop_ || generation_ != seenGeneration; });
+			if (stop_) {
+				return;
+			}
+			seenGeneration = generation_;
+		}
+
+		RunChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			--busyWorkers_;
+		}
+		doneCondition_.notify_one();
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// ワーカースレッドを使い回す並列実行用のスレッドプール
+/// </summary>
+class ThreadPool {
+public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="workerCount">ワーカー数。0 なら (論理コア数 - 1)</param>
+	explicit ThreadPool(uint32_t workerCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// 全体で共有するインスタンス
+	static ThreadPool* GetInstance();
+
+	/// <summary>
+	/// [0, count) を grainSize 個ずつに分けて並列に実行する。
+	/// 呼び出したスレッドも処理を手伝い、すべて終わるまで戻らない。
+	/// func の中からこのプールの ParallelFor を呼ぶと、分けずにその場で実行する
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">1回に処理する要素数</param>
+	/// <param name="func">[begin, end) を処理する関数</param>
+	void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& func);
+
+	// ワーカー数（呼び出し元スレッドは含まない）
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+private:
+	void WorkerLoop();
+
+	// 今の仕事を取れるだけ取って処理する
+	void RunChunks();
+
+	std::vector<std::thread> workers_;
+
+	// ParallelFor は同時に1つだけ
+	std::mutex dispatchMutex_;
+
+	std::mutex mutex_;
+	std::condition_variable wakeCondition_;
+	std::condition_variable doneCondition_;
+	uint64_t generation_ = 0;
+	uint32_t busyWorkers_ = 0;
+	bool stop_ = false;
+
+	const std::function<void(size_t, size_t)>* job_ = nullptr;
+	size_t jobCount_ = 0;
+	size_t jobGrain_ = 1;
+	std::atomic<size_t> nextIndex_{0};
+};
@@ -0,0 +1,103 @@
+#include "TransformHierarchy.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <assert.h>
+
+namespace {
+
+// 1回のタスクで処理するノード数
+const size_t kGrainSize = 256;
+
+} // namespace
+
+uint32_t TransformHierarchy::AddNode(uint32_t parent, const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	uint32_t node = GetNodeCount();
+	assert(parent == kNoParent || parent < node);
+
+	scales_.push_back(scale);
+	rotates_.push_back(rotate);
+	translates_.push_back(translate);
+	parents_.push_back(parent);
+	depths_.push_back(parent == kNoParent ? 0 : depths_[parent] + 1);
+	localMatrices_.push_back(MakeAffine3x4(MakeAffineMatrix(scale, rotate, translate)));
+	worldMatrices_.push_back({});
+	localDirty_.push_back(0);
+	worldDirty_.push_back(0);
+
+	if (updateLists_.size() <= depths_[node]) {
+		updateLists_.resize(depths_[node] + 1);
+	}
+
+	// ローカル行列は作ってあるので、ワールド行列だけ次の Update で求める
+	worldDirty_[node] = 1;
+	firstDirty_ = (std::min)(firstDirty_, node);
+	return node;
+}
+
+void TransformHierarchy::SetScale(uint32_t node, const Vector3& scale) {
+	scales_[node] = scale;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetRotate(uint32_t node, const Vector3& rotate) {
+	rotates_[node] = rotate;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetTranslate(uint32_t node, const Vector3& translate) {
+	translates_[node] = translate;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::MarkDirty(uint32_t node) {
+	localDirty_[node] = 1;
+	worldDirty_[node] = 1;
+	firstDirty_ = (std::min)(firstDirty_, node);
+}
+
+void TransformHierarchy::Update() {
+	lastUpdatedCount_ = 0;
+	// 何も変わっていなければ静的なノードには一切触れない
+	if (firstDirty_ == kNoParent) {
+		return;
+	}
+
+	// 1. 親が変わったノードに印を伝えながら、深さごとの更新リストを作る
+	//    親は必ず自分より前にあるので、前から1回なめるだけで子孫まで伝わる
+	uint32_t nodeCount = GetNodeCount();
+	for (uint32_t node = firstDirty_; node < nodeCount; ++node) {
+		uint32_t parent = parents_[node];
+		if (!worldDirty_[node] && parent != kNoParent && worldDirty_[parent]) {
+			worldDirty_[node] = 1;
+		}
+		if (worldDirty_[node]) {
+			updateLists_[depths_[node]].push_back(node);
+		}
+	}
+
+	// 2. 浅い順に、同じ深さのノードはまとめて並列に計算する
+	for (std::vector<uint32_t>& list : updateLists_) {
+		if (list.empty()) {
+			continue;
+		}
+		ThreadPool::GetInstance()->ParallelFor(list.size(), kGrainSize, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				uint32_t node = list[i];
+				if (localDirty_[node]) {
+					localMatrices_[node] = MakeAffine3x4(MakeAffineMatrix(scales_[node], rotates_[node], translates_[node]));
+				}
+				uint32_t parent = parents_[node];
+				worldMatrices_[node] = (parent == kNoParent) ? localMatrices_[node] : Multiply(localMatrices_[node], worldMatrices_[parent]);
+			}
+		});
+
+		for (uint32_t node : list) {
+			localDirty_[node] = 0;
+			worldDirty_[node] = 0;
+		}
+		lastUpdatedCount_ += static_cast<uint32_t>(list.size());
+		list.clear();
+	}
+
+	firstDirty_ = kNoParent;
+}
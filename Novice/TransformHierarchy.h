@@ -0,0 +1,74 @@
+#pragma once
+#include "Affine3x4.h"
+#include "MathFunction.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 親子関係を持つ変換をまとめて管理する。
+/// ノードは親より後ろにしか追加できないので、配列の並びがそのまま親→子の順（トポロジカル順）になる。
+/// 変更されたノードとその子孫だけをワールド行列の再計算対象にし、何も変わらなければ Update は何もしない
+/// </summary>
+class TransformHierarchy {
+public:
+	// 親がいないことを表す
+	static constexpr uint32_t kNoParent = 0xFFFFFFFF;
+
+	/// <summary>
+	/// ノードを追加する
+	/// </summary>
+	/// <param name="parent">親ノード（kNoParent ならルート）</param>
+	/// <param name="scale">拡縮</param>
+	/// <param name="rotate">回転</param>
+	/// <param name="translate">移動</param>
+	/// <returns>追加したノードの番号</returns>
+	uint32_t AddNode(uint32_t parent, const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+
+	void SetScale(uint32_t node, const Vector3& scale);
+	void SetRotate(uint32_t node, const Vector3& rotate);
+	void SetTranslate(uint32_t node, const Vector3& translate);
+
+	const Vector3& GetScale(uint32_t node) const { return scales_[node]; }
+	const Vector3& GetRotate(uint32_t node) const { return rotates_[node]; }
+	const Vector3& GetTranslate(uint32_t node) const { return translates_[node]; }
+	uint32_t GetParent(uint32_t node) const { return parents_[node]; }
+
+	/// <summary>
+	/// 変更されたノードと、その子孫のワールド行列を更新する。
+	/// 同じ深さのノード同士は依存しないので、深さごとにスレッドプールで並列に計算する
+	/// </summary>
+	void Update();
+
+	// ワールド行列（Update 後に有効）
+	Matrix4x4 GetWorldMatrix(uint32_t node) const { return MakeMatrix4x4(worldMatrices_[node]); }
+	const Affine3x4& GetWorldAffine(uint32_t node) const { return worldMatrices_[node]; }
+
+	// ノード数
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(parents_.size()); }
+
+	// 直前の Update でワールド行列を計算し直したノード数
+	uint32_t GetLastUpdatedCount() const { return lastUpdatedCount_; }
+
+private:
+	void MarkDirty(uint32_t node);
+
+	// ノードごとの値（SoA）
+	std::vector<Vector3> scales_;
+	std::vector<Vector3> rotates_;
+	std::vector<Vector3> translates_;
+	std::vector<uint32_t> parents_;
+	std::vector<uint32_t> depths_;
+	// 行列は最後の列を持たない48バイトの形で保存する
+	std::vector<Affine3x4> localMatrices_;
+	std::vector<Affine3x4> worldMatrices_;
+	std::vector<uint8_t> localDirty_; // 自分のSRTが変わった
+	std::vector<uint8_t> worldDirty_; // 自分か祖先が変わった
+
+	// 今フレームで変更されたノードの中で一番小さい番号（これより前は見なくてよい）
+	uint32_t firstDirty_ = kNoParent;
+
+	// 深さごとの更新対象（毎フレーム使い回す）
+	std::vector<std::vector<uint32_t>> updateLists_;
+
+	uint32_t lastUpdatedCount_ = 0;
+};
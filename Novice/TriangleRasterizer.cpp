@@ -0,0 +1,280 @@
+#include "TriangleRasterizer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#if defined(MATH_SIMD_SSE)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// 1つのチャンクで振り分ける三角形の数の目安（少なければスレッドに分けない）
+const size_t kTrianglesPerChunk = 1024;
+
+// 頂点の座標の絶対値の上限（ピクセル）。これを超える頂点や NaN の頂点を持つ三角形は描かない
+const float kMaxCoordinate = 1048576.0f;
+
+// 辺関数が32ビットの整数に収まる範囲（ブロックの角で評価しても足し算であふれないよう余裕を持たせる）
+const int64_t kMaxEdgeValue = int64_t(1) << 30;
+
+int64_t FloorDivide(int64_t a, int64_t b) { return (a >= 0) ? a / b : -((-a + b - 1) / b); }
+
+} // namespace
+
+TriangleRasterizer::TriangleRasterizer(ThreadPool* threadPool) : threadPool_(threadPool ? threadPool : ThreadPool::GetInstance()) {}
+
+void TriangleRasterizer::Rasterize(const ScreenTriangle* triangles, size_t count, Framebuffer& target, DepthBuffer& depth) {
+	width_ = (std::min)(target.GetWidth(), depth.GetWidth());
+	height_ = (std::min)(target.GetHeight(), depth.GetHeight());
+	tilesX_ = (width_ + kTileSize - 1) / kTileSize;
+	tilesY_ = (height_ + kTileSize - 1) / kTileSize;
+	const size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+	binnedCount_ = 0;
+	if (count == 0 || tileCount == 0) {
+		return;
+	}
+
+	// 三角形を順番のまま chunkCount_ 個に分け、チャンクごとに前計算して別々のビンへ振り分ける（ロック不要）
+	size_t maxChunks = static_cast<size_t>(threadPool_->GetWorkerCount()) + 1;
+	chunkCount_ = (std::min)((count + kTrianglesPerChunk - 1) / kTrianglesPerChunk, maxChunks);
+	setups_.resize(count);
+	if (bins_.size() < chunkCount_ * tileCount) {
+		bins_.resize(chunkCount_ * tileCount);
+	}
+	for (size_t i = 0; i < chunkCount_ * tileCount; ++i) {
+		bins_[i].clear();
+	}
+	threadPool_->ParallelFor(chunkCount_, 1, [&](size_t begin, size_t end) {
+		for (size_t chunk = begin; chunk < end; ++chunk) {
+			BinTriangles(triangles, count * chunk / chunkCount_, count * (chunk + 1) / chunkCount_, chunk);
+		}
+	});
+	for (size_t i = 0; i < chunkCount_ * tileCount; ++i) {
+		binnedCount_ += bins_[i].size();
+	}
+
+	// タイル同士は画素が重ならないので、そのまま並列に描ける
+	threadPool_->ParallelFor(tileCount, 1, [&](size_t begin, size_t end) {
+		for (size_t tile = begin; tile < end; ++tile) {
+			RasterizeTile(static_cast<int>(tile), target, depth);
+		}
+	});
+}
+
+void TriangleRasterizer::BinTriangles(const ScreenTriangle* triangles, size_t begin, size_t end, size_t chunk) {
+	std::vector<uint32_t>* bins = &bins_[chunk * static_cast<size_t>(tilesX_) * tilesY_];
+
+	for (size_t i = begin; i < end; ++i) {
+		const ScreenTriangle& triangle = triangles[i];
+		Setup& setup = setups_[i];
+		setup.minX = 1;
+		setup.maxX = 0;
+
+		// 頂点を 1/kSubpixel ピクセルの整数に丸める
+		int64_t x[3], y[3];
+		bool valid = true;
+		for (int v = 0; v < 3; ++v) {
+			const Vector3& p = triangle.vertices[v];
+			valid = valid && std::fabs(p.x) < kMaxCoordinate && std::fabs(p.y) < kMaxCoordinate;
+			x[v] = valid ? static_cast<int64_t>(std::floor(p.x * kSubpixel + 0.5f)) : 0;
+			y[v] = valid ? static_cast<int64_t>(std::floor(p.y * kSubpixel + 0.5f)) : 0;
+		}
+		int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+		if (!valid || area == 0) {
+			continue;
+		}
+		// 裏向きも描くので、面積が正になる順に並べ替える
+		int order[3] = {0, 1, 2};
+		if (area < 0) {
+			std::swap(order[1], order[2]);
+		}
+
+		// 画面に収めたバウンディングボックス（画素の中心が入りうる範囲）
+		int64_t minX = (std::min)({x[0], x[1], x[2]}), maxX = (std::max)({x[0], x[1], x[2]});
+		int64_t minY = (std::min)({y[0], y[1], y[2]}), maxY = (std::max)({y[0], y[1], y[2]});
+		minX = (std::max)(FloorDivide(minX, kSubpixel), int64_t(0));
+		minY = (std::max)(FloorDivide(minY, kSubpixel), int64_t(0));
+		maxX = (std::min)(FloorDivide(maxX, kSubpixel), int64_t(width_ - 1));
+		maxY = (std::min)(FloorDivide(maxY, kSubpixel), int64_t(height_ - 1));
+		if (minX > maxX || minY > maxY) {
+			continue;
+		}
+
+		// 辺 i（頂点 i → i + 1）の辺関数 E(P) = (Xj - Xi)(Py - Yi) - (Yj - Yi)(Px - Xi)。三角形の内側で正になる
+		const int64_t centerX = minX * kSubpixel + kSubpixel / 2;
+		const int64_t centerY = minY * kSubpixel + kSubpixel / 2;
+		// ブロックの角（バウンディングボックスから最大 kBlockSize - 1 画素外）でも32ビットに収まるか
+		const int64_t spanX = maxX - minX + kBlockSize;
+		const int64_t spanY = maxY - minY + kBlockSize;
+		bool fits = true;
+		for (int e = 0; e < 3; ++e) {
+			const int64_t xi = x[order[e]], yi = y[order[e]];
+			const int64_t xj = x[order[(e + 1) % 3]], yj = y[order[(e + 1) % 3]];
+			const int64_t stepX = -(yj - yi) * kSubpixel;
+			const int64_t stepY = (xj - xi) * kSubpixel;
+			int64_t value = (xj - xi) * (centerY - yi) - (yj - yi) * (centerX - xi);
+			// 左上ルール：辺の上に乗った画素は、片側の三角形だけが描くよう、内側が右か真下にある辺だけに含める
+			bool topLeft = stepX > 0 || (stepX == 0 && stepY > 0);
+			if (!topLeft) {
+				value -= 1;
+			}
+			fits = fits && std::llabs(value) + std::llabs(stepX) * spanX + std::llabs(stepY) * spanY < kMaxEdgeValue;
+			setup.edgeX[e] = static_cast<int32_t>(stepX);
+			setup.edgeY[e] = static_cast<int32_t>(stepY);
+			setup.edge[e] = static_cast<int32_t>(value);
+		}
+		if (!fits) {
+			continue;
+		}
+
+		// 深度は丸めた頂点を通る平面 z = z0 + a (x - x0) + b (y - y0)
+		const float inverseSubpixel = 1.0f / kSubpixel;
+		const Vector3& p0 = triangle.vertices[order[0]];
+		const Vector3& p1 = triangle.vertices[order[1]];
+		const Vector3& p2 = triangle.vertices[order[2]];
+		const float x0 = x[order[0]] * inverseSubpixel, y0 = y[order[0]] * inverseSubpixel;
+		const float dx1 = x[order[1]] * inverseSubpixel - x0, dy1 = y[order[1]] * inverseSubpixel - y0;
+		const float dx2 = x[order[2]] * inverseSubpixel - x0, dy2 = y[order[2]] * inverseSubpixel - y0;
+		const float dz1 = p1.z - p0.z, dz2 = p2.z - p0.z;
+		const float inverseArea = 1.0f / (dx1 * dy2 - dx2 * dy1);
+		setup.depthX = (dz1 * dy2 - dz2 * dy1) * inverseArea;
+		setup.depthY = (dx1 * dz2 - dx2 * dz1) * inverseArea;
+		setup.depth = p0.z + setup.depthX * (static_cast<float>(minX) + 0.5f - x0) + setup.depthY * (static_cast<float>(minY) + 0.5f - y0);
+		setup.minX = static_cast<int>(minX);
+		setup.minY = static_cast<int>(minY);
+		setup.maxX = static_cast<int>(maxX);
+		setup.maxY = static_cast<int>(maxY);
+		setup.color = triangle.color;
+
+		// バウンディングボックスにかかるタイルのうち、3辺のどれかの外側に丸ごと出ているものは外す
+		const uint32_t index = static_cast<uint32_t>(i);
+		const int tileLeft = setup.minX / kTileSize, tileRight = setup.maxX / kTileSize;
+		const int tileTop = setup.minY / kTileSize, tileBottom = setup.maxY / kTileSize;
+		for (int ty = tileTop; ty <= tileBottom; ++ty) {
+			for (int tx = tileLeft; tx <= tileRight; ++tx) {
+				bool outside = false;
+				for (int e = 0; e < 3 && !outside; ++e) {
+					int64_t value = int64_t(setup.edge[e]) + int64_t(setup.edgeX[e]) * (tx * kTileSize - minX) + int64_t(setup.edgeY[e]) * (ty * kTileSize - minY);
+					value += (std::max)(int64_t(setup.edgeX[e]) * (kTileSize - 1), int64_t(0)) + (std::max)(int64_t(setup.edgeY[e]) * (kTileSize - 1), int64_t(0));
+					outside = value < 0;
+				}
+				if (!outside) {
+					bins[ty * tilesX_ + tx].push_back(index);
+				}
+			}
+		}
+	}
+}
+
+void TriangleRasterizer::RasterizeTile(int tileIndex, Framebuffer& target, DepthBuffer& depth) const {
+	const int tileLeft = (tileIndex % tilesX_) * kTileSize;
+	const int tileTop = (tileIndex / tilesX_) * kTileSize;
+	const int tileRight = (std::min)(tileLeft + kTileSize, width_);
+	const int tileBottom = (std::min)(tileTop + kTileSize, height_);
+	const size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+	uint32_t* pixels = target.GetPixels();
+	float* depths = depth.GetDepths();
+	const size_t colorStride = static_cast<size_t>(target.GetWidth());
+	const size_t depthStride = static_cast<size_t>(depth.GetWidth());
+
+	// チャンクは三角形の順に並んでいるので、前から描けば深度が同じときは先に渡したものが残る
+	for (size_t chunk = 0; chunk < chunkCount_; ++chunk) {
+		for (uint32_t index : bins_[chunk * tileCount + tileIndex]) {
+			const Setup& s = setups_[index];
+			const int blockLeft = (std::max)(tileLeft, s.minX & ~(kBlockSize - 1));
+			const int blockTop = (std::max)(tileTop, s.minY & ~(kBlockSize - 1));
+			const int blockRight = (std::min)(tileRight - 1, s.maxX);
+			const int blockBottom = (std::min)(tileBottom - 1, s.maxY);
+
+			for (int by = blockTop; by <= blockBottom; by += kBlockSize) {
+				for (int bx = blockLeft; bx <= blockRight; bx += kBlockSize) {
+					// ブロックの左上の画素での辺関数と、ブロックの中での最大・最小
+					int32_t edge[3];
+					bool outside = false;
+					bool inside = true;
+					for (int e = 0; e < 3; ++e) {
+						edge[e] = s.edge[e] + s.edgeX[e] * (bx - s.minX) + s.edgeY[e] * (by - s.minY);
+						const int32_t spanX = s.edgeX[e] * (kBlockSize - 1);
+						const int32_t spanY = s.edgeY[e] * (kBlockSize - 1);
+						outside = outside || edge[e] + (std::max)(spanX, 0) + (std::max)(spanY, 0) < 0;
+						inside = inside && edge[e] + (std::min)(spanX, 0) + (std::min)(spanY, 0) >= 0;
+					}
+					if (outside) {
+						continue;
+					}
+
+					const int columns = (std::min)(kBlockSize, tileRight - bx);
+					const int rows = (std::min)(kBlockSize, tileBottom - by);
+					const float depthStart = s.depth + s.depthX * static_cast<float>(bx - s.minX);
+#if defined(MATH_SIMD_SSE)
+					if (columns == kBlockSize) {
+						// 1行8画素を4画素ずつ2回。辺関数の符号ビットで内側を、深度の比較で手前を判定して書き込む
+						const __m128 laneOffset[2] = {_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_setr_ps(4.0f, 5.0f, 6.0f, 7.0f)};
+						__m128i edgeRow[3], edgeStepX[3];
+						for (int e = 0; e < 3; ++e) {
+							const int32_t step = s.edgeX[e];
+							edgeRow[e] = _mm_add_epi32(_mm_set1_epi32(edge[e]), _mm_setr_epi32(0, step, step * 2, step * 3));
+							edgeStepX[e] = _mm_set1_epi32(step * 4);
+						}
+						const __m128 color = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(s.color)));
+						for (int row = 0; row < rows; ++row) {
+							const int py = by + row;
+							const float rowDepth = depthStart + s.depthY * static_cast<float>(py - s.minY);
+							const __m128 rowDepth4 = _mm_set1_ps(rowDepth);
+							const __m128 depthX = _mm_set1_ps(s.depthX);
+							__m128i e0 = edgeRow[0], e1 = edgeRow[1], e2 = edgeRow[2];
+							float* depthRow = depths + static_cast<size_t>(py) * depthStride + bx;
+							uint32_t* colorRow = pixels + static_cast<size_t>(py) * colorStride + bx;
+							for (int half = 0; half < 2; ++half) {
+								// 深度は1画素ずつのときと同じ式で求める（ビルドによって結果が変わらないように）
+								const __m128 z = _mm_add_ps(rowDepth4, _mm_mul_ps(depthX, laneOffset[half]));
+								__m128 pass = _mm_cmplt_ps(z, _mm_loadu_ps(depthRow));
+								if (!inside) {
+									const __m128i negative = _mm_srai_epi32(_mm_or_si128(_mm_or_si128(e0, e1), e2), 31);
+									pass = _mm_andnot_ps(_mm_castsi128_ps(negative), pass);
+								}
+								if (_mm_movemask_ps(pass) != 0) {
+									const __m128 oldDepth = _mm_loadu_ps(depthRow);
+									const __m128 oldColor = _mm_loadu_ps(reinterpret_cast<const float*>(colorRow));
+									_mm_storeu_ps(depthRow, _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, oldDepth)));
+									_mm_storeu_ps(reinterpret_cast<float*>(colorRow), _mm_or_ps(_mm_and_ps(pass, color), _mm_andnot_ps(pass, oldColor)));
+								}
+								e0 = _mm_add_epi32(e0, edgeStepX[0]);
+								e1 = _mm_add_epi32(e1, edgeStepX[1]);
+								e2 = _mm_add_epi32(e2, edgeStepX[2]);
+								depthRow += 4;
+								colorRow += 4;
+							}
+							for (int e = 0; e < 3; ++e) {
+								edgeRow[e] = _mm_add_epi32(edgeRow[e], _mm_set1_epi32(s.edgeY[e]));
+							}
+						}
+						continue;
+					}
+#endif
+					// 1画素ずつ（SIMD がないときと、画面の右端で8画素に満たないブロック）
+					for (int row = 0; row < rows; ++row) {
+						const int py = by + row;
+						const float rowDepth = depthStart + s.depthY * static_cast<float>(py - s.minY);
+						int32_t e0 = edge[0] + s.edgeY[0] * row;
+						int32_t e1 = edge[1] + s.edgeY[1] * row;
+						int32_t e2 = edge[2] + s.edgeY[2] * row;
+						float* depthRow = depths + static_cast<size_t>(py) * depthStride + bx;
+						uint32_t* colorRow = pixels + static_cast<size_t>(py) * colorStride + bx;
+						for (int column = 0; column < columns; ++column) {
+							const float z = rowDepth + s.depthX * static_cast<float>(column);
+							if ((e0 | e1 | e2) >= 0 && z < depthRow[column]) {
+								depthRow[column] = z;
+								colorRow[column] = s.color;
+							}
+							e0 += s.edgeX[0];
+							e1 += s.edgeX[1];
+							e2 += s.edgeX[2];
+						}
+					}
+				}
+			}
+		}
+	}
+}
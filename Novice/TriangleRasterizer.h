@@ -0,0 +1,84 @@
+#pragma once
+#include "Framebuffer.h"
+#include "MathFunction.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+// スクリーン座標の三角形1枚（x, y はピクセル、z は深度 0〜1）と RGBA の色
+struct ScreenTriangle {
+	Vector3 vertices[3];
+	uint32_t color;
+};
+
+/// <summary>
+/// スクリーン座標の三角形を深度テスト付きで塗りつぶすソフトウェアラスタライザ。
+/// 三角形を kTileSize 四方のタイルに振り分け、タイルごとに ThreadPool で並列に描く。
+/// タイルの中は kBlockSize 四方のブロック単位で辺関数を調べ、全部内側のブロックは画素ごとの判定を省く。
+/// 頂点は 1/kSubpixel ピクセルに丸めて整数の辺関数で判定するので、辺を共有する三角形の間に隙間や重なりはできない（左上ルール）
+/// </summary>
+class TriangleRasterizer {
+public:
+	// タイルの一辺（画素）
+	static constexpr int kTileSize = 64;
+	// ブロックの一辺（画素）
+	static constexpr int kBlockSize = 8;
+	// 頂点の座標の細かさ（1ピクセルの分割数）
+	static constexpr int kSubpixel = 8;
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="threadPool">使うスレッドプール（nullptr なら ThreadPool::GetInstance()）</param>
+	explicit TriangleRasterizer(ThreadPool* threadPool = nullptr);
+
+	/// <summary>
+	/// 三角形を塗る。深度が depth より小さい画素だけ色と深度を書き換える（裏向きの面も描く）。
+	/// 辺関数が32ビットに収まらないほど大きな三角形は捨てる（ScreenProjector::ClipTriangle で切ったものなら収まる）
+	/// </summary>
+	/// <param name="triangles">三角形（DebugDraw の Fill* 関数で作ったものなど）</param>
+	/// <param name="count">三角形の数</param>
+	/// <param name="target">描き込む画面</param>
+	/// <param name="depth">target と同じ大きさの深度バッファ</param>
+	void Rasterize(const ScreenTriangle* triangles, size_t count, Framebuffer& target, DepthBuffer& depth);
+
+	// 直前の Rasterize でタイルに振り分けた数（1枚が複数のタイルにかかれば、その分数える）
+	size_t GetBinnedCount() const { return binnedCount_; }
+
+private:
+	// 三角形ごとの前計算（辺関数と深度の平面の式）
+	struct Setup {
+		int32_t edgeX[3];  // 1ピクセル右へ進んだときの辺関数の増分
+		int32_t edgeY[3];  // 1ピクセル下へ進んだときの辺関数の増分
+		int32_t edge[3];   // (minX, minY) の画素の中心での辺関数（左上ルールの分を引いてあり、0以上が内側）
+		float depth;       // (minX, minY) の画素の中心での深度
+		float depthX;      // 1ピクセル右へ進んだときの深度の増分
+		float depthY;      // 1ピクセル下へ進んだときの深度の増分
+		int minX;          // 画面に収めたバウンディングボックス（両端を含む）
+		int minY;
+		int maxX;
+		int maxY;
+		uint32_t color;
+	};
+
+	// triangles[begin, end) を前計算して bins_[chunk] の各タイルへ振り分ける
+	void BinTriangles(const ScreenTriangle* triangles, size_t begin, size_t end, size_t chunk);
+
+	// タイル1枚を描く
+	void RasterizeTile(int tileIndex, Framebuffer& target, DepthBuffer& depth) const;
+
+	ThreadPool* threadPool_;
+
+	// 三角形ごとの前計算（映らない三角形は minX > maxX）
+	std::vector<Setup> setups_;
+	// [チャンク × タイル] ごとの三角形の番号。チャンクは三角形を順に分けたもので、スレッドごとに別々に書き込む
+	std::vector<std::vector<uint32_t>> bins_;
+	size_t chunkCount_ = 0;
+	int tilesX_ = 0;
+	int tilesY_ = 0;
+	int width_ = 0;
+	int height_ = 0;
+	size_t binnedCount_ = 0;
+};
@@ -0,0 +1,274 @@
+#include "Vec3Stream.h"
+#include "MathSimd.h"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+namespace {
+
+// 各成分の配列の先頭を揃える境界（AVX の1レジスタ分）
+const size_t kAlignment = 32;
+const size_t kAlignFloats = kAlignment / sizeof(float);
+
+//=== SIMD幅ごとの基本操作（一括処理はこれだけを使って1回書く） ===//
+#if defined(MATH_SIMD_AVX2)
+using Batch = __m256;
+const size_t kWidth = 8;
+inline Batch Load(const float* p) { return _mm256_load_ps(p); }
+inline void Store(float* p, Batch v) { _mm256_store_ps(p, v); }
+inline Batch Broadcast(float s) { return _mm256_set1_ps(s); }
+inline Batch Zero() { return _mm256_setzero_ps(); }
+inline Batch AddBatch(Batch a, Batch b) { return _mm256_add_ps(a, b); }
+inline Batch SubBatch(Batch a, Batch b) { return _mm256_sub_ps(a, b); }
+inline Batch MulBatch(Batch a, Batch b) { return _mm256_mul_ps(a, b); }
+inline Batch MulAddBatch(Batch a, Batch b, Batch c) { return MathSimd::MulAdd(a, b, c); }
+inline Batch SqrtBatch(Batch a) { return _mm256_sqrt_ps(a); }
+inline Batch DivBatch(Batch a, Batch b) { return _mm256_div_ps(a, b); }
+inline Batch MinBatch(Batch a, Batch b) { return _mm256_min_ps(a, b); }
+inline Batch MaxBatch(Batch a, Batch b) { return _mm256_max_ps(a, b); }
+inline Batch GreaterBatch(Batch a, Batch b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline Batch SelectBatch(Batch mask, Batch a, Batch b) { return _mm256_blendv_ps(b, a, mask); }
+#elif defined(MATH_SIMD_SSE)
+using Batch = __m128;
+const size_t kWidth = 4;
+inline Batch Load(const float* p) { return _mm_load_ps(p); }
+inline void Store(float* p, Batch v) { _mm_store_ps(p, v); }
+inline Batch Broadcast(float s) { return _mm_set1_ps(s); }
+inline Batch Zero() { return _mm_setzero_ps(); }
+inline Batch AddBatch(Batch a, Batch b) { return _mm_add_ps(a, b); }
+inline Batch SubBatch(Batch a, Batch b) { return _mm_sub_ps(a, b); }
+inline Batch MulBatch(Batch a, Batch b) { return _mm_mul_ps(a, b); }
+inline Batch MulAddBatch(Batch a, Batch b, Batch c) { return MathSimd::MulAdd(a, b, c); }
+inline Batch SqrtBatch(Batch a) { return _mm_sqrt_ps(a); }
+inline Batch DivBatch(Batch a, Batch b) { return _mm_div_ps(a, b); }
+inline Batch MinBatch(Batch a, Batch b) { return _mm_min_ps(a, b); }
+inline Batch MaxBatch(Batch a, Batch b) { return _mm_max_ps(a, b); }
+inline Batch GreaterBatch(Batch a, Batch b) { return _mm_cmpgt_ps(a, b); }
+inline Batch SelectBatch(Batch mask, Batch a, Batch b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+#else
+using Batch = float;
+const size_t kWidth = 1;
+inline Batch Load(const float* p) { return *p; }
+inline void Store(float* p, Batch v) { *p = v; }
+inline Batch Broadcast(float s) { return s; }
+inline Batch Zero() { return 0.0f; }
+inline Batch AddBatch(Batch a, Batch b) { return a + b; }
+inline Batch SubBatch(Batch a, Batch b) { return a - b; }
+inline Batch MulBatch(Batch a, Batch b) { return a * b; }
+inline Batch MulAddBatch(Batch a, Batch b, Batch c) { return a * b + c; }
+inline Batch SqrtBatch(Batch a) { return std::sqrt(a); }
+inline Batch DivBatch(Batch a, Batch b) { return a / b; }
+inline Batch MinBatch(Batch a, Batch b) { return std::min(a, b); }
+inline Batch MaxBatch(Batch a, Batch b) { return std::max(a, b); }
+inline bool GreaterBatch(Batch a, Batch b) { return a > b; }
+inline Batch SelectBatch(bool mask, Batch a, Batch b) { return mask ? a : b; }
+#endif
+
+// 容量は8の倍数に切り上げてあるので、出力が Vec3Stream なら端数も SIMD 幅のまま処理できる
+inline size_t PaddedCount(size_t count) { return (count + kWidth - 1) / kWidth * kWidth; }
+
+// 入力2つの要素数が同じか（違えばデバッグビルドでは止め、リリースビルドでは呼び出し側が何もせずに戻る）
+inline bool IsSameSize(const Vec3Stream& a, const Vec3Stream& b) {
+	assert(a.GetSize() == b.GetSize());
+	return a.GetSize() == b.GetSize();
+}
+
+} // namespace
+
+Vec3Stream::Vec3Stream(size_t size) { Resize(size); }
+
+Vec3Stream::~Vec3Stream() { Release(); }
+
+Vec3Stream::Vec3Stream(const Vec3Stream& other) {
+	Resize(other.size_);
+	std::memcpy(x_, other.x_, sizeof(float) * size_);
+	std::memcpy(y_, other.y_, sizeof(float) * size_);
+	std::memcpy(z_, other.z_, sizeof(float) * size_);
+}
+
+Vec3Stream& Vec3Stream::operator=(const Vec3Stream& other) {
+	if (this != &other) {
+		Resize(other.size_);
+		std::memcpy(x_, other.x_, sizeof(float) * size_);
+		std::memcpy(y_, other.y_, sizeof(float) * size_);
+		std::memcpy(z_, other.z_, sizeof(float) * size_);
+	}
+	return *this;
+}
+
+Vec3Stream::Vec3Stream(Vec3Stream&& other) noexcept : x_(other.x_), y_(other.y_), z_(other.z_), size_(other.size_), capacity_(other.capacity_) {
+	other.x_ = other.y_ = other.z_ = nullptr;
+	other.size_ = other.capacity_ = 0;
+}
+
+Vec3Stream& Vec3Stream::operator=(Vec3Stream&& other) noexcept {
+	if (this != &other) {
+		Release();
+		x_ = other.x_;
+		y_ = other.y_;
+		z_ = other.z_;
+		size_ = other.size_;
+		capacity_ = other.capacity_;
+		other.x_ = other.y_ = other.z_ = nullptr;
+		other.size_ = other.capacity_ = 0;
+	}
+	return *this;
+}
+
+void Vec3Stream::Resize(size_t size) {
+	if (size > capacity_) {
+		// x / y / z を1回の確保で並べる。各配列の先頭が32バイト境界に来るよう8の倍数に切り上げる
+		size_t capacity = (size + kAlignFloats - 1) / kAlignFloats * kAlignFloats;
+		float* data = static_cast<float*>(::operator new[](sizeof(float) * capacity * 3, std::align_val_t(kAlignment)));
+		std::memset(data, 0, sizeof(float) * capacity * 3);
+		if (x_) {
+			std::memcpy(data, x_, sizeof(float) * size_);
+			std::memcpy(data + capacity, y_, sizeof(float) * size_);
+			std::memcpy(data + capacity * 2, z_, sizeof(float) * size_);
+		}
+		Release();
+		x_ = data;
+		y_ = data + capacity;
+		z_ = data + capacity * 2;
+		capacity_ = capacity;
+	} else if (size > size_) {
+		std::fill(x_ + size_, x_ + size, 0.0f);
+		std::fill(y_ + size_, y_ + size, 0.0f);
+		std::fill(z_ + size_, z_ + size, 0.0f);
+	}
+	size_ = size;
+}
+
+void Vec3Stream::Release() {
+	if (x_) {
+		::operator delete[](x_, std::align_val_t(kAlignment));
+	}
+	x_ = y_ = z_ = nullptr;
+	capacity_ = 0;
+}
+
+void Add(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out) {
+	if (!IsSameSize(a, b)) {
+		return;
+	}
+	size_t count = a.GetSize();
+	out.Resize(count);
+	for (size_t i = 0; i < PaddedCount(count); i += kWidth) {
+		Store(out.X() + i, AddBatch(Load(a.X() + i), Load(b.X() + i)));
+		Store(out.Y() + i, AddBatch(Load(a.Y() + i), Load(b.Y() + i)));
+		Store(out.Z() + i, AddBatch(Load(a.Z() + i), Load(b.Z() + i)));
+	}
+}
+
+void Axpy(float s, const Vec3Stream& x, Vec3Stream& y) {
+	if (!IsSameSize(x, y)) {
+		return;
+	}
+	size_t count = x.GetSize();
+	Batch scale = Broadcast(s);
+	for (size_t i = 0; i < PaddedCount(count); i += kWidth) {
+		Store(y.X() + i, MulAddBatch(scale, Load(x.X() + i), Load(y.X() + i)));
+		Store(y.Y() + i, MulAddBatch(scale, Load(x.Y() + i), Load(y.Y() + i)));
+		Store(y.Z() + i, MulAddBatch(scale, Load(x.Z() + i), Load(y.Z() + i)));
+	}
+}
+
+void Dot(const Vec3Stream& a, const Vec3Stream& b, float* out) {
+	if (!IsSameSize(a, b)) {
+		return;
+	}
+	size_t count = a.GetSize();
+	size_t i = 0;
+	// 出力は呼び出し側の配列なので、端数はスカラーで処理する
+	for (; i + kWidth <= count; i += kWidth) {
+		Batch dot = MulBatch(Load(a.X() + i), Load(b.X() + i));
+		dot = MulAddBatch(Load(a.Y() + i), Load(b.Y() + i), dot);
+		dot = MulAddBatch(Load(a.Z() + i), Load(b.Z() + i), dot);
+#if defined(MATH_SIMD_AVX2)
+		_mm256_storeu_ps(out + i, dot);
+#elif defined(MATH_SIMD_SSE)
+		_mm_storeu_ps(out + i, dot);
+#else
+		out[i] = dot;
+#endif
+	}
+	for (; i < count; ++i) {
+		out[i] = a.X()[i] * b.X()[i] + a.Y()[i] * b.Y()[i] + a.Z()[i] * b.Z()[i];
+	}
+}
+
+void Cross(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out) {
+	if (!IsSameSize(a, b)) {
+		return;
+	}
+	size_t count = a.GetSize();
+	out.Resize(count);
+	for (size_t i = 0; i < PaddedCount(count); i += kWidth) {
+		Batch ax = Load(a.X() + i);
+		Batch ay = Load(a.Y() + i);
+		Batch az = Load(a.Z() + i);
+		Batch bx = Load(b.X() + i);
+		Batch by = Load(b.Y() + i);
+		Batch bz = Load(b.Z() + i);
+		// out が a / b と同じでもよいように、全部読んでから書く
+		Store(out.X() + i, SubBatch(MulBatch(ay, bz), MulBatch(az, by)));
+		Store(out.Y() + i, SubBatch(MulBatch(az, bx), MulBatch(ax, bz)));
+		Store(out.Z() + i, SubBatch(MulBatch(ax, by), MulBatch(ay, bx)));
+	}
+}
+
+void Length(const Vec3Stream& v, float* out) {
+	size_t count = v.GetSize();
+	size_t i = 0;
+	for (; i + kWidth <= count; i += kWidth) {
+		Batch x = Load(v.X() + i);
+		Batch y = Load(v.Y() + i);
+		Batch z = Load(v.Z() + i);
+		Batch length = SqrtBatch(MulAddBatch(z, z, MulAddBatch(y, y, MulBatch(x, x))));
+#if defined(MATH_SIMD_AVX2)
+		_mm256_storeu_ps(out + i, length);
+#elif defined(MATH_SIMD_SSE)
+		_mm_storeu_ps(out + i, length);
+#else
+		out[i] = length;
+#endif
+	}
+	for (; i < count; ++i) {
+		out[i] = std::sqrt(v.X()[i] * v.X()[i] + v.Y()[i] * v.Y()[i] + v.Z()[i] * v.Z()[i]);
+	}
+}
+
+void Normalize(const Vec3Stream& v, Vec3Stream& out) {
+	size_t count = v.GetSize();
+	out.Resize(count);
+	const Batch one = Broadcast(1.0f);
+	for (size_t i = 0; i < PaddedCount(count); i += kWidth) {
+		Batch x = Load(v.X() + i);
+		Batch y = Load(v.Y() + i);
+		Batch z = Load(v.Z() + i);
+		Batch lengthSq = MulAddBatch(z, z, MulAddBatch(y, y, MulBatch(x, x)));
+		// 長さ0の要素（末尾の詰め物を含む）は1で割ったことにする
+		Batch inverseLength = SelectBatch(GreaterBatch(lengthSq, Zero()), DivBatch(one, SqrtBatch(lengthSq)), one);
+		Store(out.X() + i, MulBatch(x, inverseLength));
+		Store(out.Y() + i, MulBatch(y, inverseLength));
+		Store(out.Z() + i, MulBatch(z, inverseLength));
+	}
+}
+
+void Clamp(const Vec3Stream& v, const Vector3& min, const Vector3& max, Vec3Stream& out) {
+	size_t count = v.GetSize();
+	out.Resize(count);
+	const Batch minX = Broadcast(min.x);
+	const Batch minY = Broadcast(min.y);
+	const Batch minZ = Broadcast(min.z);
+	const Batch maxX = Broadcast(max.x);
+	const Batch maxY = Broadcast(max.y);
+	const Batch maxZ = Broadcast(max.z);
+	for (size_t i = 0; i < PaddedCount(count); i += kWidth) {
+		Store(out.X() + i, MinBatch(MaxBatch(Load(v.X() + i), minX), maxX));
+		Store(out.Y() + i, MinBatch(MaxBatch(Load(v.Y() + i), minY), maxY));
+		Store(out.Z() + i, MinBatch(MaxBatch(Load(v.Z() + i), minZ), maxZ));
+	}
+}
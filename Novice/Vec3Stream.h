@@ -0,0 +1,124 @@
+#pragma once
+#include "MathFunction.h"
+#include <cstddef>
+
+/// <summary>
+/// 大量の Vector3 を x / y / z ごとの配列（SoA）で持つコンテナ。
+/// 各配列は32バイト境界に揃えてあり、下の一括処理関数は1回の呼び出しで全要素をSIMDで処理する。
+/// Ball や Sphere の配列とは Gather / Scatter でやり取りする
+/// </summary>
+class Vec3Stream {
+public:
+	Vec3Stream() = default;
+	explicit Vec3Stream(size_t size);
+	~Vec3Stream();
+
+	Vec3Stream(const Vec3Stream& other);
+	Vec3Stream& operator=(const Vec3Stream& other);
+	Vec3Stream(Vec3Stream&& other) noexcept;
+	Vec3Stream& operator=(Vec3Stream&& other) noexcept;
+
+	/// <summary>
+	/// 要素数を変える（増えた分は0、容量が足りていれば確保し直さない）
+	/// </summary>
+	/// <param name="size">要素数</param>
+	void Resize(size_t size);
+
+	size_t GetSize() const { return size_; }
+
+	float* X() { return x_; }
+	float* Y() { return y_; }
+	float* Z() { return z_; }
+	const float* X() const { return x_; }
+	const float* Y() const { return y_; }
+	const float* Z() const { return z_; }
+
+	Vector3 Get(size_t index) const { return {x_[index], y_[index], z_[index]}; }
+	void Set(size_t index, const Vector3& v) {
+		x_[index] = v.x;
+		y_[index] = v.y;
+		z_[index] = v.z;
+	}
+
+	/// <summary>
+	/// 構造体の配列から Vector3 のメンバーを集める（Ball の position や Sphere の center など）
+	/// </summary>
+	/// <param name="objects">構造体の配列</param>
+	/// <param name="count">個数</param>
+	/// <param name="member">集めるメンバー</param>
+	template<typename T> void Gather(const T* objects, size_t count, Vector3 T::*member) {
+		Resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			const Vector3& v = objects[i].*member;
+			x_[i] = v.x;
+			y_[i] = v.y;
+			z_[i] = v.z;
+		}
+	}
+
+	/// <summary>
+	/// 構造体の配列の Vector3 のメンバーへ書き戻す（GetSize() 個分）
+	/// </summary>
+	/// <param name="objects">構造体の配列</param>
+	/// <param name="member">書き戻すメンバー</param>
+	template<typename T> void Scatter(T* objects, Vector3 T::*member) const {
+		for (size_t i = 0; i < size_; ++i) {
+			objects[i].*member = {x_[i], y_[i], z_[i]};
+		}
+	}
+
+private:
+	void Release();
+
+	float* x_ = nullptr;
+	float* y_ = nullptr;
+	float* z_ = nullptr;
+	size_t size_ = 0;
+	size_t capacity_ = 0; // 1成分あたりの確保数（8の倍数）
+};
+
+//=== 一括処理（要素数は入力に合わせ、出力は必要なら Resize する。出力は入力と同じでもよい） ===//
+// 入力が2つ（Axpy は x と y）なら同じ要素数にする。違えば何もしない（デバッグビルドでは assert で止まる）
+
+/// <summary>
+/// out = a + b
+/// </summary>
+void Add(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+
+/// <summary>
+/// y += s * x（速度に加速度 × 時間を足すなど）
+/// </summary>
+/// <param name="s">スカラー</param>
+/// <param name="x">足すベクトル</param>
+/// <param name="y">足されるベクトル（x と同じ要素数）</param>
+void Axpy(float s, const Vec3Stream& x, Vec3Stream& y);
+
+/// <summary>
+/// 要素ごとの内積
+/// </summary>
+/// <param name="a">ベクトル１</param>
+/// <param name="b">ベクトル２</param>
+/// <param name="out">内積（a.GetSize() 個）</param>
+void Dot(const Vec3Stream& a, const Vec3Stream& b, float* out);
+
+/// <summary>
+/// out = a × b
+/// </summary>
+void Cross(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+
+/// <summary>
+/// 要素ごとの長さ
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <param name="out">長さ（v.GetSize() 個）</param>
+void Length(const Vec3Stream& v, float* out);
+
+/// <summary>
+/// 要素ごとの正規化（長さ0の要素はそのまま）
+/// </summary>
+void Normalize(const Vec3Stream& v, Vec3Stream& out);
+
+/// <summary>
+/// 成分ごとに min 以上 max 以下に収める
+/// </summary>
+void Clamp(const Vec3Stream& v, const Vector3& min, const Vector3& max, Vec3Stream& out);
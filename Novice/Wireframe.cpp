@@ -0,0 +1,60 @@
+#include "Wireframe.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+
+WireframeMesh MakeUnitSphereWireframe(uint32_t subdivision) {
+	const float kLatEvery = std::numbers::pi_v<float> / static_cast<float>(subdivision);
+	const float kLonEvery = 2.0f * std::numbers::pi_v<float> / static_cast<float>(subdivision);
+
+	WireframeMesh mesh;
+	mesh.vertices.reserve(2 + (subdivision - 1) * subdivision);
+	mesh.edges.reserve(subdivision * (2 * subdivision - 1));
+
+	// 0番が南極、最後が北極。その間に緯度ごとの輪を subdivision 個ずつ並べる
+	mesh.vertices.push_back({0.0f, -1.0f, 0.0f});
+	for (uint32_t latIndex = 1; latIndex < subdivision; ++latIndex) {
+		float lat = -std::numbers::pi_v<float> / 2.0f + kLatEvery * static_cast<float>(latIndex);
+		for (uint32_t lonIndex = 0; lonIndex < subdivision; ++lonIndex) {
+			float lon = kLonEvery * static_cast<float>(lonIndex);
+			mesh.vertices.push_back({std::cos(lat) * std::cos(lon), std::sin(lat), std::cos(lat) * std::sin(lon)});
+		}
+	}
+	const uint16_t northPole = static_cast<uint16_t>(mesh.vertices.size());
+	mesh.vertices.push_back({0.0f, 1.0f, 0.0f});
+
+	auto ringVertex = [subdivision](uint32_t latIndex, uint32_t lonIndex) { return static_cast<uint16_t>(1 + (latIndex - 1) * subdivision + lonIndex % subdivision); };
+
+	for (uint32_t lonIndex = 0; lonIndex < subdivision; ++lonIndex) {
+		// 経線（南極から北極まで）
+		uint16_t previous = 0;
+		for (uint32_t latIndex = 1; latIndex < subdivision; ++latIndex) {
+			uint16_t current = ringVertex(latIndex, lonIndex);
+			mesh.edges.push_back({previous, current});
+			previous = current;
+		}
+		mesh.edges.push_back({previous, northPole});
+
+		// 緯線（極では長さ0になるので引かない）
+		for (uint32_t latIndex = 1; latIndex < subdivision; ++latIndex) {
+			mesh.edges.push_back({ringVertex(latIndex, lonIndex), ringVertex(latIndex, lonIndex + 1)});
+		}
+	}
+	return mesh;
+}
+
+} // namespace
+
+const WireframeMesh& GetUnitSphereWireframe(uint32_t subdivision) {
+	// 全分割数をまとめて1回だけ作る（関数内 static の初期化はスレッドセーフ）
+	static const std::vector<WireframeMesh> kSpheres = [] {
+		std::vector<WireframeMesh> spheres(kMaxSphereSubdivision + 1);
+		for (uint32_t i = 1; i <= kMaxSphereSubdivision; ++i) {
+			spheres[i] = MakeUnitSphereWireframe(i);
+		}
+		return spheres;
+	}();
+	return kSpheres[std::clamp<uint32_t>(subdivision, 1, kMaxSphereSubdivision)];
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "MathFunction.h"
+#include <cstdint>
+#include <vector>
+
+// ワイヤーフレームの辺（頂点番号2つ）
+struct WireframeEdge {
+	uint16_t start;
+	uint16_t end;
+};
+
+/// <summary>
+/// 頂点を共有するワイヤーフレーム。頂点は1回ずつ変換し、辺は頂点番号で引く
+/// </summary>
+struct WireframeMesh {
+	std::vector<Vector3> vertices;
+	std::vector<WireframeEdge> edges;
+};
+
+// 球の分割数の上限
+const uint32_t kMaxSphereSubdivision = 32;
+
+/// <summary>
+/// 原点中心・半径1の球のワイヤーフレーム（緯線と経線）。
+/// 分割数ごとに最初に使ったときに1回だけ作り、以降は同じものを返す。
+/// 両極は1頂点にまとめてあるので、頂点は 2 + (分割数 - 1) × 分割数 個になる
+/// </summary>
+/// <param name="subdivision">緯度・経度の分割数（1以上 kMaxSphereSubdivision 以下に丸める）</param>
+/// <returns>ワイヤーフレーム</returns>
+const WireframeMesh& GetUnitSphereWireframe(uint32_t subdivision);